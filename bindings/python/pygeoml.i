@@ -101,6 +101,8 @@
 
 %template(CurveList) std::vector<Handle(Geom_Curve)>;
 %template(CPointContainer) std::vector<gp_Pnt>;
+%template(CPointContainerList) std::vector<std::vector<gp_Pnt>>;
+%template(BSplineCurveList) std::vector<Handle(Geom_BSplineCurve)>;
 %template(ShapeList) std::vector<geoml::Shape>;
 %template(TagTrackList) std::vector<geoml::TagTrack>;
 %template(StandardRealList) std::vector<Standard_Real>;
@@ -163,6 +165,7 @@
 }
 
 %include "geoml/geoml.h"
+%include "geoml/surfaces/SurfaceGridValues.h"
 %include "geoml/surfaces/surfaces.h"
 %include "geoml/curves/curves.h"
 %include "geoml/Continuity.h"
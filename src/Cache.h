@@ -16,8 +16,13 @@
 
 #pragma once
 
-#include <optional>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <mutex>
+#include <vector>
 
 
 namespace geoml
@@ -26,12 +31,20 @@ namespace geoml
     class ScopeLockedReference {
     public:
         ScopeLockedReference(T& reference, std::mutex& mutex)
-            : m_reference(reference), m_mutex(mutex)
+            : m_reference(reference), m_lock(mutex, std::adopt_lock)
+        {
+        }
+
+        // onRelease is called before the mutex is unlocked
+        ScopeLockedReference(T& reference, std::mutex& mutex, std::function<void()> onRelease)
+            : m_reference(reference), m_lock(mutex, std::adopt_lock), m_onRelease(std::move(onRelease))
         {
         }
 
         ~ScopeLockedReference() {
-            m_mutex.unlock();
+            if (m_lock.owns_lock() && m_onRelease) {
+                m_onRelease();
+            }
         }
 
         ScopeLockedReference(ScopeLockedReference&&) = default;
@@ -41,9 +54,24 @@ namespace geoml
 
     private:
         T& m_reference;
-        std::mutex& m_mutex;
+        std::unique_lock<std::mutex> m_lock;
+        std::function<void()> m_onRelease;
     };
 
+    /**
+     * @brief Lazily built cache of a CacheStruct, which is computed by a member function of CpacsClass
+     *
+     * Once the cache is built, reading it does not take any lock. The built state
+     * is published as a std::shared_ptr, that is loaded and stored atomically.
+     *
+     * invalidate() marks the current state as outdated without blocking.
+     * The next read rebuilds the cache. snapshot() and operator-> hand out an
+     * owning reference to the state, which is released with the last reference.
+     * The states referenced via value() or operator* are kept alive until clear(),
+     * hence prefer snapshot() for caches, that are invalidated frequently.
+     *
+     * The cache counts the hits, misses and the total time spent for building.
+     */
     template <typename CacheStruct, typename CpacsClass>
     class Cache
     {
@@ -55,45 +83,151 @@ namespace geoml
         {
         }
 
-        // constructs the cache and gives direct access to it
-        // the access is guarded for the lifetime of the returned ScopeLockedReference
+        // gives direct access to a copy of the current state (or a default constructed one)
+        // the access is guarded for the lifetime of the returned ScopeLockedReference,
+        // the modified state is published, when the reference is released. Hence, concurrent
+        // readers never see a partially written state.
+        // CacheStruct must be copy constructible, as the current state is copied.
         // prefer to rely on the build function for updating the cache
         ScopeLockedReference<CacheStruct> writeAccess() {
             std::unique_lock<std::mutex> lock(m_mutex);
-            if (!m_cache)
-                m_cache.emplace();
-            return ScopeLockedReference<CacheStruct>(*m_cache, *lock.release());
+            std::uint64_t epoch = m_epoch.load(std::memory_order_acquire);
+            if (auto entry = current()) {
+                m_pending = std::make_shared<Entry>(epoch, entry->value);
+            }
+            else {
+                m_pending = std::make_shared<Entry>(epoch);
+            }
+            return ScopeLockedReference<CacheStruct>(m_pending->value, *lock.release(), [this]() {
+                publish(std::move(m_pending));
+            });
         }
 
+        // returns an owning reference to the up to date state, building it if required
+        std::shared_ptr<const CacheStruct> snapshot() const
+        {
+            std::shared_ptr<const Entry> entry = currentOrBuild();
+            return std::shared_ptr<const CacheStruct>(entry, &entry->value);
+        }
+
+        // returns the up to date state, building it if required
+        // the reference is valid until clear() is called
         const CacheStruct& value() const
         {
-            std::lock_guard<std::mutex> guard(m_mutex);
-            if (!m_cache) {
-                m_cache.emplace();
-                try {
-                    (m_instance.*m_buildFunc)(*m_cache);
-                }
-                catch (...) {
-                    m_cache.reset();
-                    throw;
-                }
+            std::shared_ptr<const Entry> entry = currentOrBuild();
+            // the first reader of a state keeps it alive until clear()
+            if (!entry->referenced.load(std::memory_order_acquire) && !entry->referenced.exchange(true)) {
+                std::lock_guard<std::mutex> guard(m_referencedMutex);
+                m_referenced.push_back(entry);
             }
-            return m_cache.value();
+            return entry->value;
         }
 
         const CacheStruct& operator*() const { return value(); }
-        const CacheStruct* operator->() const { return &value(); }
+        std::shared_ptr<const CacheStruct> operator->() const { return snapshot(); }
 
+        // marks the cache as outdated without blocking concurrent readers
+        void invalidate() const
+        {
+            m_epoch.fetch_add(1, std::memory_order_acq_rel);
+        }
+
+        // releases all states of the cache, that are not referenced by a snapshot
+        // references obtained by value() become invalid
         void clear() const
         {
             std::lock_guard<std::mutex> guard(m_mutex);
-            m_cache.reset();
+            std::atomic_store_explicit(&m_current, std::shared_ptr<const Entry>(), std::memory_order_release);
+            std::lock_guard<std::mutex> referencedGuard(m_referencedMutex);
+            m_referenced.clear();
+        }
+
+        // number of reads that returned an already built state
+        std::uint64_t hits() const { return m_hits.load(std::memory_order_relaxed); }
+
+        // number of reads that had to build the cache
+        std::uint64_t misses() const { return m_misses.load(std::memory_order_relaxed); }
+
+        // total time spent in the build function
+        std::chrono::nanoseconds buildTime() const
+        {
+            return std::chrono::nanoseconds(m_buildTime.load(std::memory_order_relaxed));
         }
 
+        // number of invalidations
+        std::uint64_t epoch() const { return m_epoch.load(std::memory_order_acquire); }
+
     private:
+        struct Entry {
+            explicit Entry(std::uint64_t e) : epoch(e) {}
+            Entry(std::uint64_t e, const CacheStruct& v) : epoch(e), value(v) {}
+
+            std::uint64_t epoch;
+            CacheStruct value{};
+            // true, if the state has been handed out by value()
+            mutable std::atomic<bool> referenced{false};
+        };
+
+        // returns the published state, if it is up to date
+        std::shared_ptr<const Entry> current() const
+        {
+            std::shared_ptr<const Entry> entry = std::atomic_load_explicit(&m_current, std::memory_order_acquire);
+            if (entry && entry->epoch == m_epoch.load(std::memory_order_acquire)) {
+                return entry;
+            }
+            return nullptr;
+        }
+
+        // returns the up to date state, building it if required
+        std::shared_ptr<const Entry> currentOrBuild() const
+        {
+            // fast path without locking
+            if (auto entry = current()) {
+                m_hits.fetch_add(1, std::memory_order_relaxed);
+                return entry;
+            }
+
+            std::lock_guard<std::mutex> guard(m_mutex);
+            // the cache might have been built while waiting for the lock
+            if (auto entry = current()) {
+                m_hits.fetch_add(1, std::memory_order_relaxed);
+                return entry;
+            }
+
+            m_misses.fetch_add(1, std::memory_order_relaxed);
+            auto start = std::chrono::steady_clock::now();
+
+            auto entry = std::make_shared<Entry>(m_epoch.load(std::memory_order_acquire));
+            (m_instance.*m_buildFunc)(entry->value);
+
+            m_buildTime.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count(),
+                                  std::memory_order_relaxed);
+
+            publish(entry);
+            return entry;
+        }
+
+        // publishes a new state, the replaced state lives on as long as it is referenced
+        // must be called with m_mutex locked
+        void publish(std::shared_ptr<const Entry> entry) const
+        {
+            std::atomic_store_explicit(&m_current, std::move(entry), std::memory_order_release);
+        }
+
         CpacsClass& m_instance;
         BuildFunc m_buildFunc;
+        // guards building and publishing the states
         mutable std::mutex m_mutex;
-        mutable std::optional<CacheStruct> m_cache;
+        mutable std::shared_ptr<const Entry> m_current;
+        mutable std::atomic<std::uint64_t> m_epoch{0};
+        // the states handed out by value(), which are kept until clear()
+        mutable std::mutex m_referencedMutex;
+        mutable std::vector<std::shared_ptr<const Entry>> m_referenced;
+        // the state under construction by writeAccess()
+        std::shared_ptr<Entry> m_pending;
+
+        mutable std::atomic<std::uint64_t> m_hits{0};
+        mutable std::atomic<std::uint64_t> m_misses{0};
+        mutable std::atomic<std::int64_t> m_buildTime{0};
     };
 }
@@ -30,24 +30,25 @@
 CBopCommon::CBopCommon(const PNamedShape shape, const PNamedShape cuttingTool)
     :  _resultshape(), _tool(cuttingTool), _source(shape), _dsfiller(nullptr)
 {
-    _fillerAllocated = false;
     _hasPerformed = false;
 }
 
 CBopCommon::CBopCommon(const PNamedShape shape, const PNamedShape cuttingTool, const BOPAlgo_PaveFiller & filler)
     :  _resultshape(), _tool(cuttingTool), _source(shape)
 {
-    _fillerAllocated = false;
     _hasPerformed = false;
     _dsfiller = const_cast<BOPAlgo_PaveFiller*>(&filler);
 }
 
+CBopCommon::CBopCommon(const PNamedShape shape, const PNamedShape cuttingTool, PIntersectionContext context)
+    :  _resultshape(), _tool(cuttingTool), _source(shape), _context(context)
+{
+    _hasPerformed = false;
+    _dsfiller = context ? const_cast<BOPAlgo_PaveFiller*>(&context->Filler()) : nullptr;
+}
+
 CBopCommon::~CBopCommon()
 {
-    if (_fillerAllocated && _dsfiller) {
-        delete _dsfiller;
-        _dsfiller = nullptr;
-    }
 }
 
 CBopCommon::operator PNamedShape()
@@ -62,19 +63,8 @@ void CBopCommon::PrepareFiller()
     }
 
     if (!_dsfiller) {
-#if OCC_VERSION_HEX < VERSION_HEX_CODE(7,3,0)
-        BOPCol_ListOfShape aLS;
-#else
-        TopTools_ListOfShape aLS;
-#endif
-        aLS.Append(_tool->Shape());
-        aLS.Append(_source->Shape());
-
-        _dsfiller = new BOPAlgo_PaveFiller;
-        _fillerAllocated = true;
-
-        _dsfiller->SetArguments(aLS);
-        _dsfiller->Perform();
+        _context = CIntersectionContext::Get(_source->Shape(), _tool->Shape());
+        _dsfiller = const_cast<BOPAlgo_PaveFiller*>(&_context->Filler());
     }
 }
 
@@ -87,6 +77,10 @@ void CBopCommon::Perform()
         }
 
         PrepareFiller();
+        std::unique_lock<std::recursive_mutex> lock;
+        if (_context) {
+            lock = _context->Lock();
+        }
 
         // use opencascade cutting routine (might be buggy)
         BRepAlgoAPI_Common commonTool(_source->Shape(), _tool->Shape(), *_dsfiller);
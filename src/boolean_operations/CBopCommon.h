@@ -22,6 +22,7 @@
 
 #include "PNamedShape.h"
 #include "geoml_internal.h"
+#include "CIntersectionContext.h"
 
 class BOPAlgo_PaveFiller;
 
@@ -31,6 +32,7 @@ public:
     // the trimming tool must be a solid!
     GEOML_EXPORT CBopCommon(const PNamedShape shape, const PNamedShape tool);
     GEOML_EXPORT CBopCommon(const PNamedShape shape, const PNamedShape tool, const BOPAlgo_PaveFiller&);
+    GEOML_EXPORT CBopCommon(const PNamedShape shape, const PNamedShape tool, PIntersectionContext context);
     GEOML_EXPORT virtual ~CBopCommon();
 
     GEOML_EXPORT operator PNamedShape ();
@@ -45,7 +47,7 @@ protected:
 
     PNamedShape _resultshape, _tool, _source;
     BOPAlgo_PaveFiller* _dsfiller;
-    bool _fillerAllocated;
+    PIntersectionContext _context;
 
 };
 
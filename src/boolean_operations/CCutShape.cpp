@@ -34,24 +34,25 @@
 CCutShape::CCutShape(const PNamedShape shape, const PNamedShape cuttingTool)
     :  _resultshape(), _tool(cuttingTool), _source(shape), _dsfiller(NULL)
 {
-    _fillerAllocated = false;
     _hasPerformed = false;
 }
 
 CCutShape::CCutShape(const PNamedShape shape, const PNamedShape cuttingTool, const BOPAlgo_PaveFiller & filler)
     :  _resultshape(), _tool(cuttingTool), _source(shape)
 {
-    _fillerAllocated = false;
     _hasPerformed = false;
     _dsfiller = (BOPAlgo_PaveFiller*) &filler;
 }
 
+CCutShape::CCutShape(const PNamedShape shape, const PNamedShape cuttingTool, PIntersectionContext context)
+    :  _resultshape(), _tool(cuttingTool), _source(shape), _context(context)
+{
+    _hasPerformed = false;
+    _dsfiller = context ? const_cast<BOPAlgo_PaveFiller*>(&context->Filler()) : nullptr;
+}
+
 CCutShape::~CCutShape()
 {
-    if (_fillerAllocated && _dsfiller) {
-        delete _dsfiller;
-        _dsfiller = NULL;
-    }
 }
 
 CCutShape::operator PNamedShape()
@@ -66,19 +67,8 @@ void CCutShape::PrepareFiller()
     }
 
     if (!_dsfiller) {
-#if OCC_VERSION_HEX >= VERSION_HEX_CODE(7,3,0)
-        TopTools_ListOfShape aLS;
-#else
-        BOPCol_ListOfShape aLS;
-#endif
-        aLS.Append(_tool->Shape());
-        aLS.Append(_source->Shape());
-
-        _dsfiller = new BOPAlgo_PaveFiller;
-        _fillerAllocated = true;
-
-        _dsfiller->SetArguments(aLS);
-        _dsfiller->Perform();
+        _context = CIntersectionContext::Get(_source->Shape(), _tool->Shape());
+        _dsfiller = const_cast<BOPAlgo_PaveFiller*>(&_context->Filler());
     }
 }
 
@@ -91,6 +81,10 @@ void CCutShape::Perform()
         }
 
         PrepareFiller();
+        std::unique_lock<std::recursive_mutex> lock;
+        if (_context) {
+            lock = _context->Lock();
+        }
 #ifdef USE_OWN_ALGO
         CTrimShape trim1(_source, _tool, *_dsfiller, EXCLUDE);
         PNamedShape shape1 = trim1.NamedShape();
@@ -21,6 +21,7 @@
 
 #include "PNamedShape.h"
 #include "geoml_internal.h"
+#include "CIntersectionContext.h"
 
 class BOPAlgo_PaveFiller;
 
@@ -30,6 +31,7 @@ public:
     // the trimming tool must be a solid!
     GEOML_EXPORT CCutShape(const PNamedShape shape, const PNamedShape cuttingTool);
     GEOML_EXPORT CCutShape(const PNamedShape shape, const PNamedShape cuttingTool, const BOPAlgo_PaveFiller&);
+    GEOML_EXPORT CCutShape(const PNamedShape shape, const PNamedShape cuttingTool, PIntersectionContext context);
     GEOML_EXPORT virtual ~CCutShape();
 
     GEOML_EXPORT operator PNamedShape ();
@@ -49,7 +51,7 @@ protected:
 
     PNamedShape _resultshape, _tool, _source;
     BOPAlgo_PaveFiller* _dsfiller;
-    bool _fillerAllocated;
+    PIntersectionContext _context;
 
 };
 
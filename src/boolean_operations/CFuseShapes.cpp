@@ -22,9 +22,12 @@
 #include "geoml/error.h"
 #include "CBooleanOperTools.h"
 #include "CTrimShape.h"
+#include "CIntersectionContext.h"
 #include "BRepSewingToBRepBuilderShapeAdapter.h"
 
 #include <cassert>
+#include <exception>
+#include <vector>
 
 #include <TopoDS.hxx>
 #include <TopoDS_Shape.hxx>
@@ -35,17 +38,53 @@
 #include <BRepBuilderAPI_MakeSolid.hxx>
 
 #include <BOPAlgo_PaveFiller.hxx>
+#include <BRepAlgoAPI_Cut.hxx>
 #include <BRepAlgoAPI_Section.hxx>
-#include <Standard_Version.hxx>
-#if OCC_VERSION_HEX >= VERSION_HEX_CODE(7,3,0)
-#include <TopTools_ListOfShape.hxx>
-#else
-#include <BOPCol_ListOfShape.hxx>
-#endif
+#include <BRepBndLib.hxx>
+#include <Bnd_Box.hxx>
+#include <OSD_Parallel.hxx>
 
 
 //#define DEBUG_BOP
 
+namespace
+{
+    // Returns the intersection of the parent and a child. If the child is the only one,
+    // the intersection is also used to trim the parent and is shared with other
+    // operations on the same pair. Otherwise, it is a private intersection, which
+    // does not evict the shared intersections from the cache.
+    PIntersectionContext ChildContext(const TopoDS_Shape& parent, const TopoDS_Shape& child, bool shared)
+    {
+        std::vector<TopoDS_Shape> arguments{parent, child};
+        if (shared) {
+            return CIntersectionContext::Get(arguments);
+        }
+        return std::make_shared<CIntersectionContext>(arguments);
+    }
+
+    // Removes the parts of the intersection curves, that are inside of the other childs.
+    // Only the childs, whose bounding boxes overlap with the curves, are intersected.
+    TopoDS_Shape ClipWithOtherChilds(TopoDS_Shape intersection, const ListPNamedShape& childs, size_t ichild)
+    {
+        for (size_t iother = 0; iother < childs.size(); ++iother) {
+            if (iother == ichild || intersection.IsNull()) {
+                continue;
+            }
+
+            Bnd_Box intersectionBox, otherBox;
+            BRepBndLib::Add(intersection, intersectionBox);
+            BRepBndLib::Add(childs[iother]->Shape(), otherBox);
+            if (intersectionBox.IsOut(otherBox)) {
+                continue;
+            }
+
+            CIntersectionContext context(std::vector<TopoDS_Shape>{intersection, childs[iother]->Shape()});
+            intersection = BRepAlgoAPI_Cut(intersection, childs[iother]->Shape(), context.Filler());
+        }
+        return intersection;
+    }
+} // namespace
+
 CFuseShapes::CFuseShapes(const PNamedShape parent, const ListPNamedShape &childs)
     : _resultshape()
 {
@@ -130,63 +169,86 @@ void CFuseShapes::DoFuse()
         }
     }
     else {
-        // trim the childs with the parent and vice versa
-        _trimmedParent = _parent->DeepCopy();
+        ListPNamedShape childs;
         for (childIter = _childs.begin(); childIter != _childs.end(); ++childIter) {
-            const PNamedShape child = *childIter;
-            if (!child) {
-                continue;
+            if (*childIter) {
+                childs.push_back(*childIter);
             }
+        }
 
 #ifdef DEBUG_BOP
-            clock_t start, stop;
-            start = clock();
-#endif
-#if OCC_VERSION_HEX >= VERSION_HEX_CODE(7,3,0)
-            TopTools_ListOfShape aLS;
-#else
-            BOPCol_ListOfShape aLS;
-#endif
-            aLS.Append(_trimmedParent->Shape());
-            aLS.Append(child->Shape());
-            BOPAlgo_PaveFiller DSFill;
-            DSFill.SetArguments(aLS);
-            DSFill.Perform();
-#ifdef DEBUG_BOP
-            stop = clock();
-            printf("dsfiller [ms]: %f\n", (stop-start)/(double)CLOCKS_PER_SEC * 1000.);
-
-            start = clock();
+        clock_t start, stop;
+        start = clock();
 #endif
-            // calculate intersection
-            // Todo: make a new BOP out of this
-            TopoDS_Shape intersection = BRepAlgoAPI_Section(_trimmedParent->Shape(), child->Shape(), DSFill);
-            PNamedShape intersectionShape(new CNamedShape(intersection, std::string("INT" + std::string(_parent->Name()) + child->Name()).c_str()));
-            intersectionShape->SetShortName(std::string("INT" + std::string(_parent->ShortName()) + child->ShortName()).c_str());
-            _intersections.push_back(intersectionShape);
+        // Intersect and trim the childs concurrently. The results are stored by the index
+        // of the child to get the same order and names as a sequential fuse.
+        // The intersections are computed with the parent itself, not a copy of it. They
+        // do not modify their arguments, as the parent is shared by all intersections.
+        const bool singleChild = childs.size() == 1;
+        std::vector<PIntersectionContext> contexts(childs.size());
+        std::vector<PNamedShape> intersections(childs.size());
+        std::vector<PNamedShape> trimmedChilds(childs.size());
+        std::vector<std::exception_ptr> errors(childs.size());
+        OSD_Parallel::For(0, static_cast<int>(childs.size()), [&](int ichild) {
+            try {
+                const PNamedShape& child = childs[ichild];
+                PIntersectionContext context = ChildContext(_parent->Shape(), child->Shape(), singleChild);
+                std::unique_lock<std::recursive_mutex> lock = context->Lock();
+
+                // calculate intersection
+                // Todo: make a new BOP out of this
+                TopoDS_Shape intersection = BRepAlgoAPI_Section(_parent->Shape(), child->Shape(), context->Filler());
+                intersection = ClipWithOtherChilds(intersection, childs, ichild);
+                PNamedShape intersectionShape(new CNamedShape(intersection, std::string("INT" + std::string(_parent->Name()) + child->Name()).c_str()));
+                intersectionShape->SetShortName(std::string("INT" + std::string(_parent->ShortName()) + child->ShortName()).c_str());
+                intersections[ichild] = intersectionShape;
+
+                trimmedChilds[ichild] = CTrimShape(child, _parent, context, childTrim);
+                contexts[ichild] = context;
+            }
+            catch (...) {
+                errors[ichild] = std::current_exception();
+            }
+        });
 
-#ifdef DEBUG_BOP
-            stop = clock();
-            printf("intersection [ms]: %f\n", (stop-start)/(double)CLOCKS_PER_SEC * 1000.);
+        for (const std::exception_ptr& error : errors) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
 
-            start = clock();
-#endif
-            _trimmedParent = CTrimShape(_trimmedParent, child, DSFill, parentTrim);
+        _intersections.insert(_intersections.end(), intersections.begin(), intersections.end());
+        _trimmedChilds.insert(_trimmedChilds.end(), trimmedChilds.begin(), trimmedChilds.end());
 
 #ifdef DEBUG_BOP
-            stop = clock();
-            printf("parent split [ms]: %f\n", (stop-start)/(double)CLOCKS_PER_SEC * 1000.);
+        stop = clock();
+        printf("child intersections [ms]: %f\n", (stop-start)/(double)CLOCKS_PER_SEC * 1000.);
 
-            start = clock();
+        start = clock();
 #endif
-            PNamedShape trimmedChild = CTrimShape(child, _parent, DSFill, childTrim);
-            _trimmedChilds.push_back(trimmedChild);
+        // trim the parent with all childs at once
+        if (singleChild) {
+            _trimmedParent = CTrimShape(_parent, childs.front(), contexts.front(), parentTrim);
+        }
+        else if (!childs.empty()) {
+            CIntersectionContext::Options parentOptions;
+            parentOptions.runParallel = true;
+            parentOptions.nonDestructive = true;
+
+            std::vector<TopoDS_Shape> arguments(1, _parent->Shape());
+            for (const PNamedShape& child : childs) {
+                arguments.push_back(child->Shape());
+            }
+            _trimmedParent = CTrimShape(_parent, childs, CIntersectionContext::Get(arguments, parentOptions), parentTrim);
+        }
+        else {
+            _trimmedParent = _parent->DeepCopy();
+        }
 
 #ifdef DEBUG_BOP
-            stop = clock();
-            printf("child split [ms]: %f\n", (stop-start)/(double)CLOCKS_PER_SEC * 1000.);
+        stop = clock();
+        printf("parent split [ms]: %f\n", (stop-start)/(double)CLOCKS_PER_SEC * 1000.);
 #endif
-        } // trimming
     }
 
     // add trimmed child faces to result
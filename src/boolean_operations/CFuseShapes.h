@@ -30,6 +30,9 @@
  * for trimming a parent and a child. It performs at the same speed as the original
  * occt fuse, but generates more reliable values.
  *
+ * The childs are intersected and trimmed concurrently. The parent is then
+ * trimmed with all childs at once.
+ *
  * The function works only for solids!!!
  *
  */
@@ -0,0 +1,227 @@
+/*
+* Copyright (C) 2026 German Aerospace Center (DLR/SC)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "CIntersectionContext.h"
+
+#include <atomic>
+#include <functional>
+
+#include <BOPAlgo_PaveFiller.hxx>
+#include <Standard_Version.hxx>
+#if OCC_VERSION_HEX >= VERSION_HEX_CODE(7,3,0)
+#include <TopTools_ListOfShape.hxx>
+#else
+#include <BOPCol_ListOfShape.hxx>
+#endif
+
+namespace
+{
+    // order independent hash of the argument identities
+    size_t HashArguments(const std::vector<TopoDS_Shape>& arguments)
+    {
+        size_t hash = arguments.size();
+        for (const TopoDS_Shape& shape : arguments) {
+            size_t h = std::hash<const void*>()(shape.TShape().get());
+            h ^= static_cast<size_t>(shape.Orientation()) + 0x9e3779b9 + (h << 6) + (h >> 2);
+            hash += h;
+        }
+        return hash;
+    }
+
+    bool ContainsEqual(const std::vector<TopoDS_Shape>& shapes, const TopoDS_Shape& shape)
+    {
+        for (const TopoDS_Shape& s : shapes) {
+            if (s.IsEqual(shape)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::atomic<size_t> numComputed{0};
+
+    // the cache is enabled explicitly, because it keeps the arguments alive
+    const size_t defaultMaxEntries = 0;
+
+    // true, if both options result in the same intersection
+    bool SameIntersection(const CIntersectionContext::Options& a, const CIntersectionContext::Options& b)
+    {
+        return a.fuzzyValue == b.fuzzyValue &&
+               a.useOBB == b.useOBB &&
+               a.glue == b.glue &&
+               a.nonDestructive == b.nonDestructive;
+    }
+} // namespace
+
+bool CIntersectionContext::Options::operator==(const Options& other) const
+{
+    return fuzzyValue == other.fuzzyValue &&
+           runParallel == other.runParallel &&
+           useOBB == other.useOBB &&
+           glue == other.glue &&
+           nonDestructive == other.nonDestructive;
+}
+
+CIntersectionContext::CIntersectionContext(const std::vector<TopoDS_Shape>& arguments, const Options& options)
+    : _arguments(arguments), _options(options), _hash(HashArguments(arguments)), _filler(new BOPAlgo_PaveFiller)
+{
+#if OCC_VERSION_HEX >= VERSION_HEX_CODE(7,3,0)
+    TopTools_ListOfShape aLS;
+#else
+    BOPCol_ListOfShape aLS;
+#endif
+    for (const TopoDS_Shape& shape : _arguments) {
+        aLS.Append(shape);
+    }
+
+    _filler->SetArguments(aLS);
+    _filler->SetRunParallel(options.runParallel);
+    _filler->SetFuzzyValue(options.fuzzyValue);
+    _filler->SetGlue(options.glue);
+    _filler->SetNonDestructive(options.nonDestructive);
+#if OCC_VERSION_HEX >= VERSION_HEX_CODE(7,3,0)
+    _filler->SetUseOBB(options.useOBB);
+#endif
+    _filler->Perform();
+    numComputed.fetch_add(1, std::memory_order_relaxed);
+}
+
+CIntersectionContext::~CIntersectionContext()
+{
+}
+
+size_t CIntersectionContext::NumComputed()
+{
+    return numComputed.load(std::memory_order_relaxed);
+}
+
+PIntersectionContext CIntersectionContext::Get(const std::vector<TopoDS_Shape>& arguments, const Options& options)
+{
+    return CIntersectionContextCache::Instance().Get(arguments, options);
+}
+
+PIntersectionContext CIntersectionContext::Get(const TopoDS_Shape& shape1, const TopoDS_Shape& shape2, const Options& options)
+{
+    return Get(std::vector<TopoDS_Shape>{shape1, shape2}, options);
+}
+
+const BOPAlgo_PaveFiller& CIntersectionContext::Filler() const
+{
+    return *_filler;
+}
+
+bool CIntersectionContext::HasErrors() const
+{
+    return _filler->HasErrors();
+}
+
+std::unique_lock<std::recursive_mutex> CIntersectionContext::Lock() const
+{
+    return std::unique_lock<std::recursive_mutex>(_mutex);
+}
+
+bool CIntersectionContext::Matches(const std::vector<TopoDS_Shape>& arguments, const Options& options) const
+{
+    if (arguments.size() != _arguments.size() || !SameIntersection(options, _options) || HashArguments(arguments) != _hash) {
+        return false;
+    }
+
+    for (const TopoDS_Shape& shape : arguments) {
+        if (!ContainsEqual(_arguments, shape)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+CIntersectionContextCache& CIntersectionContextCache::Instance()
+{
+    static CIntersectionContextCache instance;
+    return instance;
+}
+
+CIntersectionContextCache::CIntersectionContextCache()
+    : _maxEntries(defaultMaxEntries)
+{
+}
+
+PIntersectionContext CIntersectionContextCache::Get(const std::vector<TopoDS_Shape>& arguments, const CIntersectionContext::Options& options)
+{
+    {
+        std::lock_guard<std::mutex> guard(_mutex);
+        for (auto it = _entries.begin(); it != _entries.end(); ++it) {
+            if ((*it)->Matches(arguments, options)) {
+                PIntersectionContext context = *it;
+                _entries.splice(_entries.begin(), _entries, it);
+                return context;
+            }
+        }
+    }
+
+    // the intersection is computed without holding the lock, such that
+    // independent intersections can run concurrently
+    PIntersectionContext context = std::make_shared<CIntersectionContext>(arguments, options);
+    if (context->HasErrors()) {
+        return context;
+    }
+
+    std::lock_guard<std::mutex> guard(_mutex);
+    if (_maxEntries == 0) {
+        return context;
+    }
+
+    // another thread might have computed the same context in the meantime
+    for (auto it = _entries.begin(); it != _entries.end(); ++it) {
+        if ((*it)->Matches(arguments, options)) {
+            PIntersectionContext existing = *it;
+            _entries.splice(_entries.begin(), _entries, it);
+            return existing;
+        }
+    }
+
+    _entries.push_front(context);
+    while (_entries.size() > _maxEntries) {
+        _entries.pop_back();
+    }
+    return context;
+}
+
+void CIntersectionContextCache::SetMaxEntries(size_t maxEntries)
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+    _maxEntries = maxEntries;
+    while (_entries.size() > _maxEntries) {
+        _entries.pop_back();
+    }
+}
+
+size_t CIntersectionContextCache::MaxEntries() const
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+    return _maxEntries;
+}
+
+void CIntersectionContextCache::Clear()
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+    _entries.clear();
+}
+
+size_t CIntersectionContextCache::Size() const
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+    return _entries.size();
+}
@@ -0,0 +1,142 @@
+/*
+* Copyright (C) 2026 German Aerospace Center (DLR/SC)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#ifndef CINTERSECTIONCONTEXT_H
+#define CINTERSECTIONCONTEXT_H
+
+#include "CSharedPtr.h"
+#include "geoml_internal.h"
+
+#include <BOPAlgo_GlueEnum.hxx>
+#include <TopoDS_Shape.hxx>
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class BOPAlgo_PaveFiller;
+class CIntersectionContext;
+typedef CSharedPtr<CIntersectionContext> PIntersectionContext;
+
+/**
+ * @brief CIntersectionContext holds the intersection of a set of argument shapes
+ *
+ * The intersection (the pave filler) is the expensive part of all boolean operations.
+ * Section, split, trim, cut, common and fuse of the same arguments can all be
+ * computed from a single intersection. Use CIntersectionContext::Get to retrieve
+ * the context of an argument set, which is computed only once and then cached,
+ * if the CIntersectionContextCache is enabled.
+ *
+ * The intersection data structure is modified by the operations using it. Hence,
+ * an operation must hold the lock returned by Lock() while using the filler.
+ */
+class CIntersectionContext
+{
+public:
+    /// Options of the intersection. All options except runParallel, which does not
+    /// change the result, are part of the cache key.
+    struct Options
+    {
+        double fuzzyValue = 0.;
+        bool runParallel = false;
+        bool useOBB = false;
+        BOPAlgo_GlueEnum glue = BOPAlgo_GlueOff;
+        // the contexts are shared by several operations, hence the arguments are not modified by default
+        bool nonDestructive = true;
+
+        GEOML_EXPORT bool operator==(const Options& other) const;
+    };
+
+    /// Intersects the arguments
+    GEOML_EXPORT CIntersectionContext(const std::vector<TopoDS_Shape>& arguments, const Options& options = Options());
+    GEOML_EXPORT ~CIntersectionContext();
+
+    CIntersectionContext(const CIntersectionContext&) = delete;
+    CIntersectionContext& operator=(const CIntersectionContext&) = delete;
+
+    /**
+     * @brief Returns the cached intersection context of the arguments
+     *
+     * The order of the arguments does not matter. The shapes are compared by
+     * identity, i.e. the same TShape, location and orientation.
+     */
+    GEOML_EXPORT static PIntersectionContext Get(const std::vector<TopoDS_Shape>& arguments, const Options& options = Options());
+    GEOML_EXPORT static PIntersectionContext Get(const TopoDS_Shape& shape1, const TopoDS_Shape& shape2, const Options& options = Options());
+
+    GEOML_EXPORT const BOPAlgo_PaveFiller& Filler() const;
+    GEOML_EXPORT bool HasErrors() const;
+
+    /// Locks the context for the use in a single operation
+    GEOML_EXPORT std::unique_lock<std::recursive_mutex> Lock() const;
+
+    /// Returns true, if the context was computed for exactly these arguments and equivalent options
+    GEOML_EXPORT bool Matches(const std::vector<TopoDS_Shape>& arguments, const Options& options) const;
+
+    const std::vector<TopoDS_Shape>& Arguments() const
+    {
+        return _arguments;
+    }
+
+    /// Total number of intersections computed in this process, cached or not
+    GEOML_EXPORT static size_t NumComputed();
+
+private:
+    std::vector<TopoDS_Shape> _arguments;
+    Options _options;
+    size_t _hash;
+    std::unique_ptr<BOPAlgo_PaveFiller> _filler;
+    mutable std::recursive_mutex _mutex;
+
+    friend class CIntersectionContextCache;
+};
+
+/**
+ * @brief Process wide cache of the most recently used intersection contexts
+ *
+ * The cache is disabled by default. Enable it with SetMaxEntries.
+ *
+ * The cached contexts keep their argument shapes alive. Hence, a shape
+ * of a cached context cannot be destroyed and replaced by a different shape
+ * at the same address.
+ *
+ * All methods are thread safe.
+ */
+class CIntersectionContextCache
+{
+public:
+    GEOML_EXPORT static CIntersectionContextCache& Instance();
+
+    /// Returns the cached context or computes and stores it
+    GEOML_EXPORT PIntersectionContext Get(const std::vector<TopoDS_Shape>& arguments, const CIntersectionContext::Options& options);
+
+    /// Sets the maximum number of cached contexts. 0 disables the cache.
+    GEOML_EXPORT void SetMaxEntries(size_t maxEntries);
+    GEOML_EXPORT size_t MaxEntries() const;
+
+    GEOML_EXPORT void Clear();
+    GEOML_EXPORT size_t Size() const;
+
+private:
+    CIntersectionContextCache();
+
+    mutable std::mutex _mutex;
+    size_t _maxEntries;
+    // most recently used contexts first
+    std::list<PIntersectionContext> _entries;
+};
+
+#endif // CINTERSECTIONCONTEXT_H
@@ -22,6 +22,7 @@
 #include "BRepSewingToBRepBuilderShapeAdapter.h"
 #include "common/CommonFunctions.h"
 #include "CNamedShape.h"
+#include "geometry/PointGrid.h"
 
 #include <cassert>
 #include <TopExp.hxx>
@@ -37,8 +38,37 @@
 #include <BRepBuilderAPI_Sewing.hxx>
 #include <BRepBuilderAPI_MakeSolid.hxx>
 
+#include <OSD_Parallel.hxx>
+
+#include <cmath>
+#include <exception>
 #include <vector>
 
+namespace
+{
+    // computes the central points of all faces in parallel
+    std::vector<gp_Pnt> CentralFacePoints(const TopTools_IndexedMapOfShape& faces)
+    {
+        std::vector<gp_Pnt> points(faces.Extent());
+        std::vector<std::exception_ptr> errors(faces.Extent());
+        OSD_Parallel::For(0, faces.Extent(), [&](int iface) {
+            try {
+                points[iface] = GetCentralFacePoint(TopoDS::Face(faces(iface + 1)));
+            }
+            catch (...) {
+                errors[iface] = std::current_exception();
+            }
+        });
+
+        for (const std::exception_ptr& error : errors) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+        return points;
+    }
+} // namespace
+
 CMergeShapes::CMergeShapes(const PNamedShape shape, const PNamedShape tool)
     : _tool(tool), _source(shape)
 {
@@ -107,44 +137,29 @@ void CMergeShapes::Perform()
         TopExp::MapShapes(s1->Shape(), TopAbs_FACE, m1);
         TopExp::MapShapes(s2->Shape(), TopAbs_FACE, m2);
 
-        std::vector<std::pair<TopoDS_Shape, gp_Pnt>> facesOn1, facesOn2;
-
-
-        // remove common faces
-        for (int iface = 1; iface <= m1.Extent(); ++iface){
-            const TopoDS_Face& face = TopoDS::Face(m1(iface));
-            facesOn1.push_back(std::pair<TopoDS_Shape, gp_Pnt>(m1(iface),
-                                                               GetCentralFacePoint(face)));
-
-        }
-        for (int iface = 1; iface <= m2.Extent(); ++iface){
-            const TopoDS_Face& face = TopoDS::Face(m2(iface));
-            facesOn2.push_back(std::pair<TopoDS_Shape, gp_Pnt>(m2(iface),
-                                                               GetCentralFacePoint(face)));
-
-        }
+        // remove common faces, i.e. faces with the same central point
+        std::vector<gp_Pnt> centers1 = CentralFacePoints(m1);
+        std::vector<gp_Pnt> centers2 = CentralFacePoints(m2);
 
         std::vector<bool> v1_isSame(m1.Extent(), false);
         std::vector<bool> v2_isSame(m2.Extent(), false);
 
-        for (size_t iface = 0; iface < facesOn1.size(); ++iface){
-            gp_Pnt p1 = facesOn1[iface].second;
-            for (size_t jface = 0; jface < facesOn2.size(); ++jface) {
-                gp_Pnt p2 = facesOn2[jface].second;
-                if (p1.SquareDistance(p2) < Precision::Confusion()) {
-                    v1_isSame[iface] = true;
-                    v2_isSame[jface] = true;
-                }
-            }
+        const double tolerance = std::sqrt(Precision::Confusion());
+        geoml::PointGrid grid(centers2, tolerance);
+        for (size_t iface = 0; iface < centers1.size(); ++iface) {
+            grid.ForEachNeighbor(centers1[iface], tolerance, [&](size_t jface) {
+                v1_isSame[iface] = true;
+                v2_isSame[jface] = true;
+            });
         }
-        for (size_t iface = 0; iface < facesOn1.size(); ++iface) {
+        for (size_t iface = 0; iface < v1_isSame.size(); ++iface) {
             if (!v1_isSame[iface]) {
-                v1.push_back(facesOn1[iface].first);
+                v1.push_back(m1(static_cast<int>(iface) + 1));
             }
         }
-        for (size_t iface = 0; iface < facesOn2.size(); ++iface) {
+        for (size_t iface = 0; iface < v2_isSame.size(); ++iface) {
             if (!v2_isSame[iface]) {
-                v2.push_back(facesOn2[iface].first);
+                v2.push_back(m2(static_cast<int>(iface) + 1));
             }
         }
 
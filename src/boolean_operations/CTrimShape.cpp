@@ -25,8 +25,10 @@
 #include "geoml/error.h"
 #include "CNamedShape.h"
 
+#include <atomic>
 #include <cassert>
 #include <string>
+#include <vector>
 
 #include <BOPAlgo_PaveFiller.hxx>
 
@@ -54,7 +56,7 @@
 namespace
 {
 
-    static unsigned int itrim = 0;
+    static std::atomic<unsigned int> itrim(0);
 
 
     // Writes shape and its central face points into brep file (for debugging purposes)
@@ -75,18 +77,52 @@ namespace
         }
 
         std::stringstream str;
-        str << "trim_" << itrim << "_" << name << ".brep";
+        str << "trim_" << itrim.load() << "_" << name << ".brep";
 
         BRepTools::Write(c, str.str().c_str());
     }
 
-    TopoDS_Shape GetFacesNotInShape(BRepBuilderAPI_MakeShape& bop, const TopoDS_Shape& originalShape, const TopoDS_Shape& splittedShape, const TopoDS_Shape& shapeToExInclude, TrimOperation op)
+    // Returns true, if a face with the point p is part of the trimming result
+    bool KeepFace(std::vector<BRepClass3d_SolidClassifier>& classifiers, const gp_Pnt& p, TrimOperation op)
+    {
+        switch (op) {
+        case EXCLUDE:
+            // the face must be outside of all tools
+            for (BRepClass3d_SolidClassifier& classifier : classifiers) {
+                classifier.Perform(p, Precision::Confusion());
+                if (classifier.State() == TopAbs_IN || classifier.State() == TopAbs_ON) {
+                    return false;
+                }
+            }
+            return true;
+        case INCLUDE:
+            // the face must be inside of any tool
+            for (BRepClass3d_SolidClassifier& classifier : classifiers) {
+                classifier.Perform(p, Precision::Confusion());
+                if (classifier.State() == TopAbs_IN) {
+                    return true;
+                }
+            }
+            return false;
+        default:
+            printf("illegal operation\n");
+        }
+        return false;
+    }
+
+    TopoDS_Shape GetFacesNotInShape(BRepBuilderAPI_MakeShape& bop, const TopoDS_Shape& originalShape, const TopoDS_Shape& splittedShape, const ListPNamedShape& shapesToExInclude, TrimOperation op)
     {
 
         TopoDS_Compound compound;
         BRep_Builder compoundmaker;
         compoundmaker.MakeCompound(compound);
 
+        // the classifiers are loaded only once for all faces
+        std::vector<BRepClass3d_SolidClassifier> classifiers(shapesToExInclude.size());
+        for (size_t itool = 0; itool < shapesToExInclude.size(); ++itool) {
+            classifiers[itool].Load(shapesToExInclude[itool]->Shape());
+        }
+
         // add splitted faces to compound
         TopTools_IndexedMapOfShape originMap;
         TopExp::MapShapes(originalShape,   TopAbs_FACE, originMap);
@@ -99,25 +135,8 @@ namespace
                 TopoDS_Face splitface = TopoDS::Face(it.Value());
                 gp_Pnt p = GetCentralFacePoint(splitface);
 
-                // check if point is in shapeToExclude
-                BRepClass3d_SolidClassifier classifier;
-                classifier.Load(shapeToExInclude);
-                classifier.Perform(p, Precision::Confusion());
-
-
-                switch (op) {
-                case EXCLUDE:
-                    if (classifier.State() != TopAbs_IN && classifier.State() != TopAbs_ON) {
-                        compoundmaker.Add(compound, splitface);
-                    }
-                    break;
-                case INCLUDE:
-                    if (classifier.State() == TopAbs_IN) {
-                        compoundmaker.Add(compound, splitface);
-                    }
-                    break;
-                default:
-                    printf("illegal operation\n");
+                if (KeepFace(classifiers, p, op)) {
+                    compoundmaker.Add(compound, splitface);
                 }
             }
         }
@@ -133,25 +152,8 @@ namespace
                 const TopoDS_Face& originalFace = TopoDS::Face(originMap.FindKey(index));
                 gp_Pnt p = GetCentralFacePoint(originalFace);
 
-                // check if point is in shapeToExclude
-                BRepClass3d_SolidClassifier classifier;
-                classifier.Load(shapeToExInclude);
-                classifier.Perform(p, Precision::Confusion());
-
-
-                switch (op) {
-                case EXCLUDE:
-                    if (classifier.State() != TopAbs_IN && classifier.State() != TopAbs_ON) {
-                        compoundmaker.Add(compound, originalFace);
-                    }
-                    break;
-                case INCLUDE:
-                    if (classifier.State() == TopAbs_IN) {
-                        compoundmaker.Add(compound, originalFace);
-                    }
-                    break;
-                default:
-                    printf("illegal operation\n");
+                if (KeepFace(classifiers, p, op)) {
+                    compoundmaker.Add(compound, originalFace);
                 }
             }
         }
@@ -162,26 +164,40 @@ namespace
 } // namespace
 
 CTrimShape::CTrimShape(const PNamedShape shape, const PNamedShape trimmingTool, TrimOperation op)
-    : _operation(op), _resultshape(), _tool(trimmingTool), _source(shape), _dsfiller(NULL)
+    : _operation(op), _resultshape(), _source(shape), _tools(1, trimmingTool), _dsfiller(NULL)
 {
-    _fillerAllocated = false;
     _hasPerformed = false;
 }
 
 CTrimShape::CTrimShape(const PNamedShape shape, const PNamedShape trimmingTool, const BOPAlgo_PaveFiller & filler, TrimOperation op)
-    : _operation(op), _resultshape(), _tool(trimmingTool), _source(shape)
+    : _operation(op), _resultshape(), _source(shape), _tools(1, trimmingTool)
 {
-    _fillerAllocated = false;
     _hasPerformed = false;
     _dsfiller = (BOPAlgo_PaveFiller*) &filler;
 }
 
+CTrimShape::CTrimShape(const PNamedShape shape, const PNamedShape trimmingTool, PIntersectionContext context, TrimOperation op)
+    : _operation(op), _resultshape(), _source(shape), _tools(1, trimmingTool), _context(context)
+{
+    _hasPerformed = false;
+    _dsfiller = context ? const_cast<BOPAlgo_PaveFiller*>(&context->Filler()) : nullptr;
+}
+
+CTrimShape::CTrimShape(const PNamedShape shape, const ListPNamedShape& trimmingTools, TrimOperation op)
+    : _operation(op), _resultshape(), _source(shape), _tools(trimmingTools), _dsfiller(nullptr)
+{
+    _hasPerformed = false;
+}
+
+CTrimShape::CTrimShape(const PNamedShape shape, const ListPNamedShape& trimmingTools, PIntersectionContext context, TrimOperation op)
+    : _operation(op), _resultshape(), _source(shape), _tools(trimmingTools), _context(context)
+{
+    _hasPerformed = false;
+    _dsfiller = context ? const_cast<BOPAlgo_PaveFiller*>(&context->Filler()) : nullptr;
+}
+
 CTrimShape::~CTrimShape()
 {
-    if (_fillerAllocated && _dsfiller) {
-        delete _dsfiller;
-        _dsfiller = NULL;
-    }
 }
 
 CTrimShape::operator PNamedShape()
@@ -191,24 +207,17 @@ CTrimShape::operator PNamedShape()
 
 void CTrimShape::PrepareFiller()
 {
-    if (!_tool || !_source) {
+    if (_tools.empty() || !_source) {
         return;
     }
 
     if (!_dsfiller) {
-#if OCC_VERSION_HEX >= VERSION_HEX_CODE(7,3,0)
-        TopTools_ListOfShape aLS;
-#else
-        BOPCol_ListOfShape aLS;
-#endif
-        aLS.Append(_tool->Shape());
-        aLS.Append(_source->Shape());
-
-        _dsfiller = new BOPAlgo_PaveFiller;
-        _fillerAllocated = true;
-
-        _dsfiller->SetArguments(aLS);
-        _dsfiller->Perform();
+        std::vector<TopoDS_Shape> arguments(1, _source->Shape());
+        for (const PNamedShape& tool : _tools) {
+            arguments.push_back(tool->Shape());
+        }
+        _context = CIntersectionContext::Get(arguments);
+        _dsfiller = const_cast<BOPAlgo_PaveFiller*>(&_context->Filler());
     }
 }
 
@@ -219,32 +228,48 @@ void CTrimShape::Perform()
                 throw geoml::Error("Null pointer for source argument in CTrimShape", geoml::NULL_POINTER);
         }
 
-        if (!_tool) {
+        if (_tools.empty()) {
+                throw geoml::Error("No tool argument in CTrimShape", geoml::NULL_POINTER);
+        }
+
+        for (const PNamedShape& tool : _tools) {
+            if (!tool) {
                 throw geoml::Error("Null pointer for tool argument in CTrimShape", geoml::NULL_POINTER);
+            }
         }
 
         bool debug = (getenv("GEOML_DEBUG_BOP") != NULL);
 
         if (debug) {
             WriteDebugShape(_source->Shape(), "source");
-            WriteDebugShape(_tool->Shape(), "tool");
+            for (const PNamedShape& tool : _tools) {
+                WriteDebugShape(tool->Shape(), "tool");
+            }
         }
 
         PrepareFiller();
+        std::unique_lock<std::recursive_mutex> lock;
+        if (_context) {
+            lock = _context->Lock();
+        }
         GEOMAlgo_Splitter splitter;
         BOPBuilderShapeToBRepBuilderShapeAdapter splitAdapter(splitter);
         splitter.AddArgument(_source->Shape());
-        splitter.AddTool(_tool->Shape());
+        for (const PNamedShape& tool : _tools) {
+            splitter.AddTool(tool->Shape());
+        }
         splitter.PerformWithFiller(*_dsfiller);
 
         if (debug) {
             WriteDebugShape(splitter.Shape(), "split");
         }
 
-        TopoDS_Shape trimmedShape = GetFacesNotInShape(splitAdapter, _source->Shape(), splitter.Shape(), _tool->Shape(), _operation);
+        TopoDS_Shape trimmedShape = GetFacesNotInShape(splitAdapter, _source->Shape(), splitter.Shape(), _tools, _operation);
         _resultshape = PNamedShape(new CNamedShape(trimmedShape, _source->Name()));
         CBooleanOperTools::MapFaceNamesAfterBOP(splitAdapter, _source, _resultshape);
-        CBooleanOperTools::MapFaceNamesAfterBOP(splitAdapter, _tool,   _resultshape);
+        for (const PNamedShape& tool : _tools) {
+            CBooleanOperTools::MapFaceNamesAfterBOP(splitAdapter, tool, _resultshape);
+        }
 
         // create shell
         _resultshape = CBooleanOperTools::Shellify(_resultshape);
@@ -20,7 +20,9 @@
 #define CTRIMSHAPE_H
 
 #include "PNamedShape.h"
+#include "ListPNamedShape.h"
 #include "geoml_internal.h"
+#include "CIntersectionContext.h"
 
 class BOPAlgo_PaveFiller;
 
@@ -36,6 +38,12 @@ public:
     // the trimming tool must be a solid!
     GEOML_EXPORT CTrimShape(const PNamedShape shape, const PNamedShape trimmingTool, TrimOperation = EXCLUDE);
     GEOML_EXPORT CTrimShape(const PNamedShape shape, const PNamedShape trimmingTool, const BOPAlgo_PaveFiller&, TrimOperation = EXCLUDE);
+    GEOML_EXPORT CTrimShape(const PNamedShape shape, const PNamedShape trimmingTool, PIntersectionContext context, TrimOperation = EXCLUDE);
+
+    // trims the shape with multiple tools at once
+    // EXCLUDE keeps the faces outside of all tools, INCLUDE the faces inside of any tool
+    GEOML_EXPORT CTrimShape(const PNamedShape shape, const ListPNamedShape& trimmingTools, TrimOperation = EXCLUDE);
+    GEOML_EXPORT CTrimShape(const PNamedShape shape, const ListPNamedShape& trimmingTools, PIntersectionContext context, TrimOperation = EXCLUDE);
     GEOML_EXPORT virtual ~CTrimShape();
 
     GEOML_EXPORT operator PNamedShape ();
@@ -49,9 +57,10 @@ protected:
     bool _hasPerformed;
     TrimOperation _operation;
 
-    PNamedShape _resultshape, _tool, _source;
+    PNamedShape _resultshape, _source;
+    ListPNamedShape _tools;
     BOPAlgo_PaveFiller* _dsfiller;
-    bool _fillerAllocated;
+    PIntersectionContext _context;
 
 };
 
@@ -35,6 +35,7 @@
 #include "geoml/error.h"
 #include "CNamedShape.h"
 #include "boolean_operations/CBooleanOperTools.h"
+#include "boolean_operations/CIntersectionContext.h"
 #include "boolean_operations/BRepSewingToBRepBuilderShapeAdapter.h"
 #include "ListPNamedShape.h"
 #include "CNamedShape.h"
@@ -1407,6 +1408,14 @@ TopoDS_Shape SplitShape(const TopoDS_Shape& src, const TopoDS_Shape& tool)
 #endif
 
     for (int i = 0;; i++) {
+        // the intersection is shared with other splits of the same shapes
+        CIntersectionContext::Options options;
+#if OCC_VERSION_HEX >= VERSION_HEX_CODE(6,9,0)
+        options.fuzzyValue = fuzzyValue;
+#endif
+        PIntersectionContext context = CIntersectionContext::Get(src, tool, options);
+        std::unique_lock<std::recursive_mutex> lock = context->Lock();
+
         GEOMAlgo_Splitter splitter;
         splitter.AddArgument(src);
         splitter.AddTool(tool);
@@ -1414,7 +1423,7 @@ TopoDS_Shape SplitShape(const TopoDS_Shape& src, const TopoDS_Shape& tool)
         splitter.SetFuzzyValue(fuzzyValue);
 #endif
         try {
-            splitter.Perform();
+            splitter.PerformWithFiller(context->Filler());
         }
         catch (const Standard_Failure& f) {
             std::stringstream ss;
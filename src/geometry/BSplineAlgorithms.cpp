@@ -20,6 +20,7 @@
 #include "BSplineAlgorithms.h"
 #include "geometry/CurvesToSurface.h"
 #include "geoml/error.h"
+#include "BSplineBasisMatrix.h"
 #include "BSplineApproxInterp.h"
 #include "PointsToBSplineInterpolation.h"
 #include "common/CommonFunctions.h"
@@ -49,11 +50,13 @@
 #include <Precision.hxx>
 #include <Geom2dAPI_ProjectPointOnCurve.hxx>
 #include <GCPnts_AbscissaPoint.hxx>
+#include <OSD_Parallel.hxx>
 
 #include <cmath>
 #include <stdexcept>
 #include <algorithm>
 #include <cassert>
+#include <exception>
 
 namespace
 {
@@ -263,15 +266,32 @@ namespace
         }
 
 
-        // now insert knots from first into all others
-        for (typename std::vector<SplineAdapter>::iterator splineIt = splines_vector.begin()+1; splineIt != splines_vector.end(); ++splineIt) {
-            SplineAdapter& spline = *splineIt;
-            for (int knot_idx = 2; knot_idx < firstSpline.getNKnots(); ++knot_idx) {
-                double knot = firstSpline.getKnot(knot_idx);
-                int mult = firstSpline.getMult(knot_idx);
-                spline.insertKnot(knot, mult, par_tolerance);
+        // now insert knots from first into all others. The splines are independent copies,
+        // hence this is done in parallel
+        std::vector<std::exception_ptr> errors(splines_vector.size());
+        OSD_Parallel::For(1, static_cast<int>(splines_vector.size()), [&](int spline_idx) {
+            SplineAdapter& spline = splines_vector[static_cast<size_t>(spline_idx)];
+            try {
+                for (int knot_idx = 2; knot_idx < firstSpline.getNKnots(); ++knot_idx) {
+                    double knot = firstSpline.getKnot(knot_idx);
+                    int mult = firstSpline.getMult(knot_idx);
+                    spline.insertKnot(knot, mult, par_tolerance);
+                }
             }
-            if (spline.getNKnots() != firstSpline.getNKnots()) {
+            catch (...) {
+                // exceptions must not leave the parallel loop. They are rethrown after the loop.
+                errors[static_cast<size_t>(spline_idx)] = std::current_exception();
+            }
+        });
+
+        for (const auto& error : errors) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+
+        for (size_t spline_idx = 1; spline_idx < splines_vector.size(); ++spline_idx) {
+            if (splines_vector[spline_idx].getNKnots() != firstSpline.getNKnots()) {
                 throw geoml::Error("Unexpected error in Algorithm makeGeometryCompatibleImpl.\nPlease contact the developers.");
             }
         }
@@ -728,16 +748,16 @@ Handle(Geom_BSplineSurface) BSplineAlgorithms::pointsToSurface(const TColgp_Arra
     bool makeVDirClosed = vContinuousIfClosed & isVDirClosed(points, tolerance);
     bool makeUDirClosed = uContinuousIfClosed & isUDirClosed(points, tolerance);
 
-    // first interpolate all points by B-splines in u-direction
-    std::vector<Handle(Geom_Curve)> uSplines;
+    // first interpolate all points by B-splines in u-direction.
+    // All columns share the same parameters, hence the interpolation system is factorized only once.
+    std::vector<Handle(TColgp_HArray1OfPnt)> uPoints;
     for (int cpVIdx = points.LowerCol(); cpVIdx <= points.UpperCol(); ++cpVIdx) {
-        Handle_TColgp_HArray1OfPnt points_u = pntArray2GetColumn(points, cpVIdx);
-        PointsToBSplineInterpolation interpolationObject(points_u, uParams, 3, makeUDirClosed);
-
-        Handle(Geom_Curve) curve = interpolationObject.Curve();
-        uSplines.push_back(curve);
+        uPoints.push_back(pntArray2GetColumn(points, cpVIdx));
     }
 
+    std::vector<Handle(Geom_BSplineCurve)> uBSplines = PointsToBSplineInterpolation::Curves(uPoints, uParams, 3, makeUDirClosed);
+    std::vector<Handle(Geom_Curve)> uSplines(uBSplines.begin(), uBSplines.end());
+
     // now create a skinned surface with these B-splines which represents the interpolating surface
     CurvesToSurface skinner(uSplines, vParams, makeVDirClosed );
     Handle(Geom_BSplineSurface) interpolatingSurf = skinner.Surface();
@@ -836,29 +856,7 @@ ApproxResult BSplineAlgorithms::reparametrizeBSplineNiceKnots(Handle(Geom_BSplin
 
 math_Matrix BSplineAlgorithms::bsplineBasisMat(int degree, const TColStd_Array1OfReal& knots, const TColStd_Array1OfReal& params, unsigned int derivOrder)
 {
-    Standard_Integer ncp = knots.Length() - degree - 1;
-    math_Matrix mx(1, params.Length(), 1, ncp);
-    mx.Init(0.);
-    math_Matrix bspl_basis(1, derivOrder + 1, 1, degree + 1);
-    bspl_basis.Init(0.);
-    for (Standard_Integer iparm = 1; iparm <= params.Length(); ++iparm) {
-        Standard_Integer basis_start_index = 0;
-#if OCC_VERSION_HEX >= VERSION_HEX_CODE(7,1,0)
-        BSplCLib::EvalBsplineBasis(derivOrder, degree + 1, knots, params.Value(iparm), basis_start_index, bspl_basis);
-#else
-        BSplCLib::EvalBsplineBasis(1, derivOrder, degree + 1, knots, params.Value(iparm), basis_start_index, bspl_basis);
-#endif
-        if(derivOrder > 0) {
-            math_Vector help_vector(1, ncp);
-            help_vector.Init(0.);
-            help_vector.Set(basis_start_index, basis_start_index + degree, bspl_basis.Row(derivOrder + 1));
-            mx.SetRow(iparm, help_vector);
-        }
-        else {
-            mx.Set(iparm, iparm, basis_start_index, basis_start_index + degree, bspl_basis);
-        }
-    }
-    return mx;
+    return BSplineBasisMatrix(degree, knots, params, derivOrder).ToDense();
 }
 
 std::vector<double> BSplineAlgorithms::getKinkParameters(const Handle(Geom_BSplineCurve)& curve)
@@ -84,6 +84,8 @@ public:
      * @param flatKnots Flatted know vector
      * @param params    Parameters of B-Spline evaluation
      * @return          The B-spline matrix
+     *
+     * @see BSplineBasisMatrix for a sparse representation
      */
     GEOML_EXPORT static math_Matrix bsplineBasisMat(int degree, const TColStd_Array1OfReal& flatKnots, const TColStd_Array1OfReal& params, unsigned int derivOrder=0);
 
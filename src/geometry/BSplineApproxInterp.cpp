@@ -20,6 +20,8 @@
 
 #include <geoml/error.h>
 #include <BSplineAlgorithms.h>
+#include "BSplineBasisMatrix.h"
+#include "math/BandedMatrix.h"
 
 #include <TColgp_Array1OfPnt.hxx>
 #include <Geom_BSplineCurve.hxx>
@@ -89,6 +91,7 @@ BSplineApproxInterp::BSplineApproxInterp(const TColgp_Array1OfPnt& points, int n
     , m_degree(degree)
     , m_ncp(nControlPoints)
     , m_C2Continuous(continuous_if_closed)
+    , m_solverType(BandedSolver)
 {
     for (Standard_Integer i = 0; i < points.Length(); ++i) {
         size_t idx = static_cast<size_t>(i);
@@ -97,6 +100,11 @@ BSplineApproxInterp::BSplineApproxInterp(const TColgp_Array1OfPnt& points, int n
     }
 }
 
+void BSplineApproxInterp::SetSolverType(SolverType type)
+{
+    m_solverType = type;
+}
+
 void BSplineApproxInterp::InterpolatePoint(size_t pointIndex, bool withKink)
 {
     std::vector<size_t>::iterator it = std::find(m_indexOfApproximated.begin(), m_indexOfApproximated.end(), pointIndex);
@@ -325,24 +333,18 @@ math_Matrix BSplineApproxInterp::getContinuityMatrix(int nCtrPnts, int contin_co
 {
     math_Matrix continuity_entries(1, contin_cons, 1, nCtrPnts);
     continuity_entries.Init(0.);
-    TColStd_Array1OfReal continuity_params1(params[0], 1, 1);
-    TColStd_Array1OfReal continuity_params2(params[params.size() - 1], 1, 1);
-    
-    math_Matrix diff1_1 = BSplineAlgorithms::bsplineBasisMat(m_degree, flatKnots, continuity_params1, 1);
-    math_Matrix diff1_2 = BSplineAlgorithms::bsplineBasisMat(m_degree, flatKnots, continuity_params2, 1);
-    
-    math_Matrix diff2_1 = BSplineAlgorithms::bsplineBasisMat(m_degree, flatKnots, continuity_params1, 2);
-    math_Matrix diff2_2 = BSplineAlgorithms::bsplineBasisMat(m_degree, flatKnots, continuity_params2, 2);
-
-    // Set C1 condition
-    continuity_entries.Set(1, 1, 1, nCtrPnts, diff1_1 - diff1_2);
-    
-    // Set C2 consition
-    continuity_entries.Set(2, 2, 1, nCtrPnts, diff2_1 - diff2_2);
-    if (!firstAndLastInterpolated()) {
-        math_Matrix diff0_1 = BSplineAlgorithms::bsplineBasisMat(m_degree, flatKnots, continuity_params1, 0);
-        math_Matrix diff0_2 = BSplineAlgorithms::bsplineBasisMat(m_degree, flatKnots, continuity_params2, 0);
-        continuity_entries.Set(3, 3, 1, nCtrPnts, diff0_1 - diff0_2);
+    std::vector<double> continuity_params;
+    continuity_params.push_back(params.front());
+    continuity_params.push_back(params.back());
+
+    // Row 1: C1 condition, row 2: C2 condition, row 3: C0 condition (if required)
+    const unsigned int derivOrders[] = {1, 2, 0};
+    for (int icon = 1; icon <= contin_cons; ++icon) {
+        BSplineBasisMatrix diff(m_degree, flatKnots, continuity_params, derivOrders[icon - 1]);
+        for (int k = 0; k < diff.RowLength(); ++k) {
+            continuity_entries(icon, diff.RowStart(1) + k) += diff.RowValues(1)[k];
+            continuity_entries(icon, diff.RowStart(2) + k) -= diff.RowValues(2)[k];
+        }
     }
     return continuity_entries;
 }
@@ -381,32 +383,60 @@ ApproxResult BSplineApproxInterp::solve(const std::vector<double>& params, const
         throw geoml::Error("Wrong number of control points for curve interpolation!");
     }
 
+    TColgp_Array1OfPnt poles(1, nCtrPnts);
+
+    bool solved = false;
+    if (m_solverType == BandedSolver && n_apprxmated > 0) {
+        solved = solveBanded(params, flatKnots, n_continuityConditions, poles);
+    }
+    if (!solved) {
+        solveDense(params, flatKnots, n_continuityConditions, poles);
+    }
+
+    ApproxResult result;
+    result.curve = new Geom_BSplineCurve(poles, knots, mults, m_degree, false);
+
+    // compute error
+    double max_error = 0.;
+    for (std::vector<size_t>::const_iterator it_idx = m_indexOfApproximated.begin(); it_idx != m_indexOfApproximated.end(); ++it_idx) {
+        Standard_Integer ipnt = static_cast<Standard_Integer>(*it_idx + 1);
+        const gp_Pnt& p = m_pnts.Value(ipnt);
+        double par = params[*it_idx];
+
+        double error = result.curve->Value(par).Distance(p);
+        max_error = std::max(max_error, error);
+    }
+    result.error = max_error;
+
+    return result;
+}
+
+void BSplineApproxInterp::solveDense(const std::vector<double>& params, const TColStd_Array1OfReal& flatKnots, int n_continuityConditions, TColgp_Array1OfPnt& poles) const
+{
+    Standard_Integer n_apprxmated = static_cast<Standard_Integer>(m_indexOfApproximated.size());
+    Standard_Integer n_intpolated = static_cast<Standard_Integer>(m_indexOfInterpolated.size());
+    Standard_Integer nCtrPnts = poles.Length();
+    bool makeClosed = n_continuityConditions > 0;
+
     // Build left hand side of the equation
     Standard_Integer n_vars = nCtrPnts + n_intpolated + n_continuityConditions;
     math_Matrix lhs(1, n_vars, 1, n_vars);
     lhs.Init(0.);
     
-    // Allocate right hand side
-    math_Vector rhsx(1, n_vars);
-    math_Vector rhsy(1, n_vars);
-    math_Vector rhsz(1, n_vars);
+    // Allocate right hand side, the columns are the x, y and z coordinates
+    math_Matrix rhs(1, n_vars, 1, 3, 0.);
 
     if (n_apprxmated > 0) {
         // Write b vector. These are the points to be approximated
-        TColStd_Array1OfReal appParams(1, n_apprxmated);
-        math_Vector bx(1, n_apprxmated);
-        math_Vector by(1, n_apprxmated);
-        math_Vector bz(1, n_apprxmated);
-    
-        Standard_Integer appIndex = 1;
-        for (std::vector<size_t>::const_iterator it_idx = m_indexOfApproximated.begin(); it_idx != m_indexOfApproximated.end(); ++it_idx) {
-            Standard_Integer ipnt = static_cast<Standard_Integer>(*it_idx + 1);
-            const gp_Pnt& p = m_pnts.Value(ipnt);
-            bx(appIndex) = p.X();
-            by(appIndex) = p.Y();
-            bz(appIndex) = p.Z();
-            appParams(appIndex) = params[*it_idx];
-            appIndex++;
+        std::vector<double> appParams(m_indexOfApproximated.size());
+        math_Matrix b(1, n_apprxmated, 1, 3);
+        for (Standard_Integer appIndex = 1; appIndex <= n_apprxmated; ++appIndex) {
+            size_t ipnt = m_indexOfApproximated[static_cast<size_t>(appIndex - 1)];
+            const gp_Pnt& p = m_pnts.Value(static_cast<Standard_Integer>(ipnt + 1));
+            appParams[static_cast<size_t>(appIndex - 1)] = params[ipnt];
+            b(appIndex, 1) = p.X();
+            b(appIndex, 2) = p.Y();
+            b(appIndex, 3) = p.Z();
         }
 
         // Solve constrained linear least squares
@@ -414,37 +444,33 @@ ApproxResult BSplineApproxInterp::solve(const std::vector<double>& params, const
         // Create left hand side block matrix
         // A.T*A  C.T
         // C      0
-        math_Matrix A = BSplineAlgorithms::bsplineBasisMat(m_degree, flatKnots, appParams);
-        math_Matrix At = A.Transposed();
+        BSplineBasisMatrix A(m_degree, flatKnots, appParams);
 
-        lhs.Set(1, nCtrPnts, 1, nCtrPnts, At.Multiplied(A));
-
-        rhsx.Set(1, nCtrPnts, At.Multiplied(bx));
-        rhsy.Set(1, nCtrPnts, At.Multiplied(by));
-        rhsz.Set(1, nCtrPnts, At.Multiplied(bz));
+        lhs.Set(1, nCtrPnts, 1, nCtrPnts, A.TransposedTimesSelf().ToDense());
+        rhs.Set(1, nCtrPnts, 1, 3, A.TransposedMultiplied(b));
     }
 
     if (n_intpolated + n_continuityConditions > 0) {
         // Write d vector. These are the points that should be interpolated as well as the continuity constraints for closed curve
-        math_Vector dx(1, n_intpolated + n_continuityConditions, 0.);
-        math_Vector dy(1, n_intpolated + n_continuityConditions, 0.);
-        math_Vector dz(1, n_intpolated + n_continuityConditions, 0.);
         if(n_intpolated > 0) {
-            TColStd_Array1OfReal interpParams(1, n_intpolated);
-            Standard_Integer intpIndex = 1;
-            for (std::vector<size_t>::const_iterator it_idx = m_indexOfInterpolated.begin(); it_idx != m_indexOfInterpolated.end(); ++it_idx) {
-                Standard_Integer ipnt = static_cast<Standard_Integer>(*it_idx + 1);
-                const gp_Pnt& p = m_pnts.Value(ipnt);
-                dx(intpIndex) = p.X();
-                dy(intpIndex) = p.Y();
-                dz(intpIndex) = p.Z();
-                interpParams(intpIndex) = params[*it_idx];
-                intpIndex++;
+            std::vector<double> interpParams(m_indexOfInterpolated.size());
+            for (Standard_Integer intpIndex = 1; intpIndex <= n_intpolated; ++intpIndex) {
+                size_t ipnt = m_indexOfInterpolated[static_cast<size_t>(intpIndex - 1)];
+                const gp_Pnt& p = m_pnts.Value(static_cast<Standard_Integer>(ipnt + 1));
+                interpParams[static_cast<size_t>(intpIndex - 1)] = params[ipnt];
+                rhs(nCtrPnts + intpIndex, 1) = p.X();
+                rhs(nCtrPnts + intpIndex, 2) = p.Y();
+                rhs(nCtrPnts + intpIndex, 3) = p.Z();
+            }
+            BSplineBasisMatrix C(m_degree, flatKnots, interpParams);
+            for (Standard_Integer irow = 1; irow <= n_intpolated; ++irow) {
+                const double* values = C.RowValues(irow);
+                for (Standard_Integer k = 0; k < C.RowLength(); ++k) {
+                    Standard_Integer icol = C.RowStart(irow) + k;
+                    lhs(nCtrPnts + irow, icol) = values[k];
+                    lhs(icol, nCtrPnts + irow) = values[k];
+                }
             }
-            math_Matrix C = BSplineAlgorithms::bsplineBasisMat(m_degree, flatKnots, interpParams);
-            math_Matrix Ct = C.Transposed();
-            lhs.Set(1, nCtrPnts, nCtrPnts + 1, nCtrPnts + n_intpolated, Ct);
-            lhs.Set(nCtrPnts + 1,  nCtrPnts + n_intpolated, 1, nCtrPnts, C);
         }
 
         // sets the C2 continuity constraints for closed curves on the left hand side if requested
@@ -453,54 +479,115 @@ ApproxResult BSplineApproxInterp::solve(const std::vector<double>& params, const
             lhs.Set(nCtrPnts + n_intpolated + 1, nCtrPnts + n_intpolated + n_continuityConditions, 1, nCtrPnts, continuity_entries);
             lhs.Set(1, nCtrPnts, nCtrPnts + n_intpolated + 1, nCtrPnts + n_intpolated + n_continuityConditions, continuity_entries.Transposed());
         }
-        rhsx.Set(nCtrPnts + 1, n_vars, dx);
-        rhsy.Set(nCtrPnts + 1, n_vars, dy);
-        rhsz.Set(nCtrPnts + 1, n_vars, dz);
     }
 
     math_Gauss solver(lhs);
-
-    math_Vector cp_x(1, n_vars);
-    math_Vector cp_y(1, n_vars);
-    math_Vector cp_z(1, n_vars);
-
-    solver.Solve(rhsx, cp_x);
     if (!solver.IsDone()) {
         throw Error("Singular Matrix", geoml::MATH_ERROR);
     }
 
-    solver.Solve(rhsy, cp_y);
-    if (!solver.IsDone()) {
-        throw Error("Singular Matrix", geoml::MATH_ERROR);
+    math_Matrix cp(1, n_vars, 1, 3);
+    for (Standard_Integer icoord = 1; icoord <= 3; ++icoord) {
+        math_Vector cp_i(1, n_vars);
+        solver.Solve(rhs.Col(icoord), cp_i);
+        if (!solver.IsDone()) {
+            throw Error("Singular Matrix", geoml::MATH_ERROR);
+        }
+        cp.SetCol(icoord, cp_i);
     }
 
-    solver.Solve(rhsz, cp_z);
-    if (!solver.IsDone()) {
-        throw Error("Singular Matrix", geoml::MATH_ERROR);
+    for (Standard_Integer icp = 1; icp <= nCtrPnts; ++icp) {
+        poles.SetValue(icp, gp_Pnt(cp(icp, 1), cp(icp, 2), cp(icp, 3)));
     }
+}
 
-    TColgp_Array1OfPnt poles(1, nCtrPnts);
-    for (Standard_Integer icp = 1; icp <= nCtrPnts; ++icp) {
-        gp_Pnt pnt(cp_x.Value(icp), cp_y.Value(icp), cp_z.Value(icp));
-        poles.SetValue(icp, pnt);
+bool BSplineApproxInterp::solveBanded(const std::vector<double>& params, const TColStd_Array1OfReal& flatKnots, int n_continuityConditions, TColgp_Array1OfPnt& poles) const
+{
+    Standard_Integer n_apprxmated = static_cast<Standard_Integer>(m_indexOfApproximated.size());
+    Standard_Integer n_intpolated = static_cast<Standard_Integer>(m_indexOfInterpolated.size());
+    Standard_Integer n_constraints = n_intpolated + n_continuityConditions;
+    Standard_Integer nCtrPnts = poles.Length();
+
+    // Assemble the normal equations A^T*A X = A^T*B of the points to be approximated.
+    // As each row of A has only degree+1 non-zero entries, A^T*A is a band matrix.
+    // The x, y and z coordinates are the columns of B and solved at once.
+    std::vector<double> appParams(m_indexOfApproximated.size());
+    math_Matrix B(1, n_apprxmated, 1, 3);
+    for (Standard_Integer appIndex = 1; appIndex <= n_apprxmated; ++appIndex) {
+        size_t ipnt = m_indexOfApproximated[static_cast<size_t>(appIndex - 1)];
+        const gp_Pnt& p = m_pnts.Value(static_cast<Standard_Integer>(ipnt + 1));
+        appParams[static_cast<size_t>(appIndex - 1)] = params[ipnt];
+        B(appIndex, 1) = p.X();
+        B(appIndex, 2) = p.Y();
+        B(appIndex, 3) = p.Z();
+    }
+
+    BSplineBasisMatrix A(m_degree, flatKnots, appParams);
+    SymmetricBandedMatrix AtA = A.TransposedTimesSelf();
+    math_Matrix X = A.TransposedMultiplied(B);
+
+    if (!AtA.Factorize()) {
+        // some control points are not determined by the approximated points alone
+        return false;
     }
-    
-    ApproxResult result;
-    result.curve = new Geom_BSplineCurve(poles, knots, mults, m_degree, false);
 
-    // compute error
-    double max_error = 0.;
-    for (std::vector<size_t>::const_iterator it_idx = m_indexOfApproximated.begin(); it_idx != m_indexOfApproximated.end(); ++it_idx) {
-        Standard_Integer ipnt = static_cast<Standard_Integer>(*it_idx + 1);
-        const gp_Pnt& p = m_pnts.Value(ipnt);
-        double par = params[*it_idx];
+    // unconstrained solution
+    AtA.Solve(X);
 
-        double error = result.curve->Value(par).Distance(p);
-        max_error = std::max(max_error, error);
+    if (n_constraints > 0) {
+        // Solve constrained linear least squares
+        // min(Ax - b) s.t. Gx = d
+        // via the Schur complement S = G*(A^T*A)^-1*G^T of the constraints
+        math_Matrix G(1, n_constraints, 1, nCtrPnts, 0.);
+        math_Matrix D(1, n_constraints, 1, 3, 0.);
+
+        if (n_intpolated > 0) {
+            std::vector<double> interpParams(m_indexOfInterpolated.size());
+            for (Standard_Integer intpIndex = 1; intpIndex <= n_intpolated; ++intpIndex) {
+                size_t ipnt = m_indexOfInterpolated[static_cast<size_t>(intpIndex - 1)];
+                const gp_Pnt& p = m_pnts.Value(static_cast<Standard_Integer>(ipnt + 1));
+                interpParams[static_cast<size_t>(intpIndex - 1)] = params[ipnt];
+                D(intpIndex, 1) = p.X();
+                D(intpIndex, 2) = p.Y();
+                D(intpIndex, 3) = p.Z();
+            }
+            BSplineBasisMatrix C(m_degree, flatKnots, interpParams);
+            for (Standard_Integer irow = 1; irow <= n_intpolated; ++irow) {
+                for (Standard_Integer k = 0; k < C.RowLength(); ++k) {
+                    G(irow, C.RowStart(irow) + k) = C.RowValues(irow)[k];
+                }
+            }
+        }
+
+        if (n_continuityConditions > 0) {
+            G.Set(n_intpolated + 1, n_constraints, 1, nCtrPnts, getContinuityMatrix(nCtrPnts, n_continuityConditions, params, flatKnots));
+        }
+
+        // W = (A^T*A)^-1 * G^T
+        math_Matrix W = G.Transposed();
+        AtA.Solve(W);
+
+        math_Gauss schur(G.Multiplied(W));
+        if (!schur.IsDone()) {
+            return false;
+        }
+
+        math_Matrix residual = G.Multiplied(X) - D;
+        math_Matrix lambda(1, n_constraints, 1, 3);
+        for (Standard_Integer icoord = 1; icoord <= 3; ++icoord) {
+            math_Vector lambda_i(1, n_constraints);
+            schur.Solve(residual.Col(icoord), lambda_i);
+            lambda.SetCol(icoord, lambda_i);
+        }
+
+        X -= W.Multiplied(lambda);
     }
-    result.error = max_error;
 
-    return result;
+    for (Standard_Integer icp = 1; icp <= nCtrPnts; ++icp) {
+        poles.SetValue(icp, gp_Pnt(X(icp, 1), X(icp, 2), X(icp, 3)));
+    }
+
+    return true;
 }
 
 /**
@@ -48,8 +48,21 @@ struct ProjectResult
 class BSplineApproxInterp
 {
 public:
+    /// Linear solvers for the constrained least squares system
+    enum SolverType
+    {
+        /// Solves the full KKT system with a dense Gauss solver. This is the reference implementation.
+        DenseSolver,
+        /// Solves the normal equations with a banded Cholesky solver and the constraints via their
+        /// Schur complement. Falls back to the dense solver, if the normal equations are singular.
+        BandedSolver
+    };
+
     GEOML_EXPORT BSplineApproxInterp(const TColgp_Array1OfPnt& points, int nControlPoints, int degree = 3, bool continuous_if_closed = false);
 
+    /// Selects the linear solver. Default is the BandedSolver.
+    GEOML_EXPORT void SetSolverType(SolverType type);
+
     /// The specified point will be interpolated instead of approximated
     GEOML_EXPORT void InterpolatePoint(size_t pointIndex, bool withKink=false);
 
@@ -66,6 +79,8 @@ private:
     void computeKnots(int ncp, const std::vector<double>& params, std::vector<double>& knots, std::vector<int>& mults) const;
     
     ApproxResult solve(const std::vector<double>& params, const TColStd_Array1OfReal& knots, const TColStd_Array1OfInteger& mults) const;
+    void solveDense(const std::vector<double>& params, const TColStd_Array1OfReal& flatKnots, int n_continuityConditions, TColgp_Array1OfPnt& poles) const;
+    bool solveBanded(const std::vector<double>& params, const TColStd_Array1OfReal& flatKnots, int n_continuityConditions, TColgp_Array1OfPnt& poles) const;
     math_Matrix getContinuityMatrix(int nCtrPnts, int contin_cons, const std::vector<double>& params, const TColStd_Array1OfReal& flatKnots) const;
 
     void optimizeParameters(const Handle(Geom_Curve)& curve, std::vector<double>& parms) const;
@@ -91,6 +106,9 @@ private:
 
     /// determines the continuous closing of curve
     bool  m_C2Continuous;
+
+    /// the linear solver used for the fit
+    SolverType m_solverType;
 };
 
 } // namespace geoml
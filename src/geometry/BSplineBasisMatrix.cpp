@@ -0,0 +1,215 @@
+/*
+* Copyright (C) 2026 German Aerospace Center (DLR/SC)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "BSplineBasisMatrix.h"
+#include "BSplineEvaluator.h"
+
+#include "geoml/error.h"
+
+#include <BSplCLib.hxx>
+#include <Standard_Version.hxx>
+
+namespace geoml
+{
+
+BSplineBasisMatrix::BSplineBasisMatrix(int degree, const TColStd_Array1OfReal& flatKnots, const TColStd_Array1OfReal& params, unsigned int derivOrder)
+    : m_nCols(flatKnots.Length() - degree - 1)
+    , m_rowLength(degree + 1)
+    , m_rowStart(static_cast<size_t>(params.Length()), 1)
+    , m_values(static_cast<size_t>(params.Length()) * static_cast<size_t>(degree + 1), 0.)
+{
+    math_Matrix basis(1, derivOrder + 1, 1, degree + 1, 0.);
+    for (int row = 1; row <= params.Length(); ++row) {
+        evaluate(degree, flatKnots, row, params.Value(params.Lower() + row - 1), derivOrder, basis);
+    }
+}
+
+BSplineBasisMatrix::BSplineBasisMatrix(int degree, const TColStd_Array1OfReal& flatKnots, const std::vector<double>& params, unsigned int derivOrder)
+    : m_nCols(flatKnots.Length() - degree - 1)
+    , m_rowLength(degree + 1)
+    , m_rowStart(params.size(), 1)
+    , m_values(params.size() * static_cast<size_t>(degree + 1), 0.)
+{
+    math_Matrix basis(1, derivOrder + 1, 1, degree + 1, 0.);
+    for (size_t i = 0; i < params.size(); ++i) {
+        evaluate(degree, flatKnots, static_cast<int>(i + 1), params[i], derivOrder, basis);
+    }
+}
+
+void BSplineBasisMatrix::evaluate(int degree, const TColStd_Array1OfReal& flatKnots, int row, double param, unsigned int derivOrder, math_Matrix& basis)
+{
+    double* values = m_values.data() + static_cast<size_t>(row - 1) * static_cast<size_t>(m_rowLength);
+
+    if (derivOrder == 0) {
+        // fast path using the degree specialized kernels
+        const double* knots = &flatKnots.First();
+        int span = bspline::FindSpan(degree, m_nCols, knots, param);
+        bspline::BasisFunctions(degree, span, param, knots, values);
+        m_rowStart[static_cast<size_t>(row - 1)] = span - degree + 1;
+        return;
+    }
+
+    Standard_Integer basis_start_index = 0;
+#if OCC_VERSION_HEX >= VERSION_HEX_CODE(7,1,0)
+    BSplCLib::EvalBsplineBasis(derivOrder, degree + 1, flatKnots, param, basis_start_index, basis);
+#else
+    BSplCLib::EvalBsplineBasis(1, derivOrder, degree + 1, flatKnots, param, basis_start_index, basis);
+#endif
+    m_rowStart[static_cast<size_t>(row - 1)] = basis_start_index;
+
+    for (int k = 0; k < m_rowLength; ++k) {
+        values[k] = basis(static_cast<int>(derivOrder) + 1, k + 1);
+    }
+}
+
+int BSplineBasisMatrix::RowNumber() const
+{
+    return static_cast<int>(m_rowStart.size());
+}
+
+int BSplineBasisMatrix::ColNumber() const
+{
+    return m_nCols;
+}
+
+int BSplineBasisMatrix::RowLength() const
+{
+    return m_rowLength;
+}
+
+double BSplineBasisMatrix::Value(int row, int col) const
+{
+    if (row < 1 || row > RowNumber() || col < 1 || col > m_nCols) {
+        throw Error("Index out of range in BSplineBasisMatrix::Value", geoml::INDEX_ERROR);
+    }
+
+    int k = col - RowStart(row);
+    if (k < 0 || k >= m_rowLength) {
+        return 0.;
+    }
+    return RowValues(row)[k];
+}
+
+SymmetricBandedMatrix BSplineBasisMatrix::TransposedTimesSelf() const
+{
+    SymmetricBandedMatrix AtA(m_nCols, m_rowLength - 1);
+    for (int row = 1; row <= RowNumber(); ++row) {
+        int start = RowStart(row);
+        const double* values = RowValues(row);
+        for (int i = 0; i < m_rowLength; ++i) {
+            for (int j = 0; j <= i; ++j) {
+                AtA(start + i, start + j) += values[i] * values[j];
+            }
+        }
+    }
+    return AtA;
+}
+
+math_Vector BSplineBasisMatrix::TransposedMultiplied(const math_Vector& b) const
+{
+    if (b.Length() != RowNumber()) {
+        throw Error("Dimension mismatch in BSplineBasisMatrix::TransposedMultiplied", geoml::MATH_ERROR);
+    }
+
+    math_Vector result(1, m_nCols, 0.);
+    for (int row = 1; row <= RowNumber(); ++row) {
+        int start = RowStart(row);
+        const double* values = RowValues(row);
+        double brow = b(b.Lower() + row - 1);
+        for (int k = 0; k < m_rowLength; ++k) {
+            result(start + k) += values[k] * brow;
+        }
+    }
+    return result;
+}
+
+math_Matrix BSplineBasisMatrix::TransposedMultiplied(const math_Matrix& B) const
+{
+    if (B.RowNumber() != RowNumber()) {
+        throw Error("Dimension mismatch in BSplineBasisMatrix::TransposedMultiplied", geoml::MATH_ERROR);
+    }
+
+    const int ncols = B.ColNumber();
+    math_Matrix result(1, m_nCols, 1, ncols, 0.);
+    for (int row = 1; row <= RowNumber(); ++row) {
+        int start = RowStart(row);
+        const double* values = RowValues(row);
+        const double* brow = &B(B.LowerRow() + row - 1, B.LowerCol());
+        for (int k = 0; k < m_rowLength; ++k) {
+            double* rrow = &result(start + k, 1);
+            for (int c = 0; c < ncols; ++c) {
+                rrow[c] += values[k] * brow[c];
+            }
+        }
+    }
+    return result;
+}
+
+math_Vector BSplineBasisMatrix::Multiplied(const math_Vector& x) const
+{
+    if (x.Length() != m_nCols) {
+        throw Error("Dimension mismatch in BSplineBasisMatrix::Multiplied", geoml::MATH_ERROR);
+    }
+
+    math_Vector result(1, RowNumber(), 0.);
+    for (int row = 1; row <= RowNumber(); ++row) {
+        int start = x.Lower() + RowStart(row) - 1;
+        const double* values = RowValues(row);
+        double sum = 0.;
+        for (int k = 0; k < m_rowLength; ++k) {
+            sum += values[k] * x(start + k);
+        }
+        result(row) = sum;
+    }
+    return result;
+}
+
+math_Matrix BSplineBasisMatrix::Multiplied(const math_Matrix& X) const
+{
+    if (X.RowNumber() != m_nCols) {
+        throw Error("Dimension mismatch in BSplineBasisMatrix::Multiplied", geoml::MATH_ERROR);
+    }
+
+    const int ncols = X.ColNumber();
+    math_Matrix result(1, RowNumber(), 1, ncols, 0.);
+    for (int row = 1; row <= RowNumber(); ++row) {
+        int start = X.LowerRow() + RowStart(row) - 1;
+        const double* values = RowValues(row);
+        double* rrow = &result(row, 1);
+        for (int k = 0; k < m_rowLength; ++k) {
+            const double* xrow = &X(start + k, X.LowerCol());
+            for (int c = 0; c < ncols; ++c) {
+                rrow[c] += values[k] * xrow[c];
+            }
+        }
+    }
+    return result;
+}
+
+math_Matrix BSplineBasisMatrix::ToDense() const
+{
+    math_Matrix mx(1, RowNumber(), 1, m_nCols, 0.);
+    for (int row = 1; row <= RowNumber(); ++row) {
+        int start = RowStart(row);
+        const double* values = RowValues(row);
+        for (int k = 0; k < m_rowLength; ++k) {
+            mx(row, start + k) = values[k];
+        }
+    }
+    return mx;
+}
+
+} // namespace geoml
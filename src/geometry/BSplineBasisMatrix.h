@@ -0,0 +1,108 @@
+/*
+* Copyright (C) 2026 German Aerospace Center (DLR/SC)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#pragma once
+
+#include "geoml_internal.h"
+#include "math/BandedMatrix.h"
+
+#include <TColStd_Array1OfReal.hxx>
+#include <math_Matrix.hxx>
+#include <math_Vector.hxx>
+
+#include <vector>
+
+namespace geoml
+{
+
+/**
+ * @brief Sparse B-spline basis matrix
+ *
+ * Row i of the matrix contains the values (or derivatives) of all B-spline
+ * basis functions at the parameter params(i). Only degree+1 basis functions
+ * are non-zero at any parameter and these are consecutive. Hence, each row is
+ * stored as the index of its first non-zero column followed by degree+1 values.
+ * This requires O(n*degree) memory instead of O(n*m) for the full matrix.
+ *
+ * As for math_Matrix, indices start at 1.
+ */
+class BSplineBasisMatrix
+{
+public:
+    /**
+     * @brief Evaluates the B-spline basis at the given parameters
+     * @param degree     Degree of the bspline
+     * @param flatKnots  Flat knot vector
+     * @param params     Parameters of B-Spline evaluation
+     * @param derivOrder Order of the derivative of the basis functions
+     */
+    GEOML_EXPORT BSplineBasisMatrix(int degree, const TColStd_Array1OfReal& flatKnots, const TColStd_Array1OfReal& params, unsigned int derivOrder = 0);
+
+    /// Same as above, using a std::vector of parameters
+    GEOML_EXPORT BSplineBasisMatrix(int degree, const TColStd_Array1OfReal& flatKnots, const std::vector<double>& params, unsigned int derivOrder = 0);
+
+    /// Returns the number of rows, i.e. the number of parameters
+    GEOML_EXPORT int RowNumber() const;
+
+    /// Returns the number of columns, i.e. the number of control points
+    GEOML_EXPORT int ColNumber() const;
+
+    /// Returns the number of non-zero entries per row, i.e. degree + 1
+    GEOML_EXPORT int RowLength() const;
+
+    /// Returns the column index of the first non-zero entry of the given row
+    int RowStart(int row) const
+    {
+        return m_rowStart[static_cast<size_t>(row - 1)];
+    }
+
+    /// Returns a pointer to the RowLength() non-zero entries of the given row
+    const double* RowValues(int row) const
+    {
+        return m_values.data() + static_cast<size_t>(row - 1) * static_cast<size_t>(m_rowLength);
+    }
+
+    /// Returns the entry A(row, col)
+    GEOML_EXPORT double Value(int row, int col) const;
+
+    /// Computes A^T*A, which is a symmetric band matrix of bandwidth degree
+    GEOML_EXPORT SymmetricBandedMatrix TransposedTimesSelf() const;
+
+    /// Computes A^T*b. b must have RowNumber() entries.
+    GEOML_EXPORT math_Vector TransposedMultiplied(const math_Vector& b) const;
+
+    /// Computes A^T*B for all columns of B at once. B must have RowNumber() rows.
+    GEOML_EXPORT math_Matrix TransposedMultiplied(const math_Matrix& B) const;
+
+    /// Computes A*x. x must have ColNumber() entries.
+    GEOML_EXPORT math_Vector Multiplied(const math_Vector& x) const;
+
+    /// Computes A*X for all columns of X at once. X must have ColNumber() rows.
+    GEOML_EXPORT math_Matrix Multiplied(const math_Matrix& X) const;
+
+    /// Returns the matrix as a dense math_Matrix
+    GEOML_EXPORT math_Matrix ToDense() const;
+
+private:
+    void evaluate(int degree, const TColStd_Array1OfReal& flatKnots, int row, double param, unsigned int derivOrder, math_Matrix& basis);
+
+    int m_nCols;
+    int m_rowLength;
+    std::vector<int> m_rowStart;
+    std::vector<double> m_values;
+};
+
+} // namespace geoml
@@ -0,0 +1,452 @@
+/*
+* Copyright (C) 2026 German Aerospace Center (DLR/SC)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "BSplineEvaluator.h"
+
+#include "geoml/error.h"
+
+#include <TColStd_Array1OfReal.hxx>
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+
+std::vector<double> flatKnots(const TColStd_Array1OfReal& knots)
+{
+    return std::vector<double>(&knots.First(), &knots.First() + knots.Length());
+}
+
+} // namespace
+
+namespace geoml
+{
+
+namespace bspline
+{
+
+int FindSpan(int degree, int nPoles, const double* flatKnots, double u)
+{
+    if (u >= flatKnots[nPoles]) {
+        return nPoles - 1;
+    }
+    if (u <= flatKnots[degree]) {
+        return degree;
+    }
+
+    // first knot larger than u
+    const double* it = std::upper_bound(flatKnots + degree, flatKnots + nPoles + 1, u);
+    return static_cast<int>(it - flatKnots) - 1;
+}
+
+void BasisFunctions(int degree, int span, double u, const double* flatKnots, double* N)
+{
+    switch (degree) {
+    case 1:
+        return BasisFunctions<1>(span, u, flatKnots, N);
+    case 2:
+        return BasisFunctions<2>(span, u, flatKnots, N);
+    case 3:
+        return BasisFunctions<3>(span, u, flatKnots, N);
+    case 4:
+        return BasisFunctions<4>(span, u, flatKnots, N);
+    case 5:
+        return BasisFunctions<5>(span, u, flatKnots, N);
+    default:
+        break;
+    }
+
+    if (degree < 0 || degree > MAX_DEGREE) {
+        throw Error("Invalid degree in bspline::BasisFunctions", geoml::MATH_ERROR);
+    }
+
+    double left[MAX_DEGREE + 1];
+    double right[MAX_DEGREE + 1];
+    N[0] = 1.;
+    for (int j = 1; j <= degree; ++j) {
+        left[j] = u - flatKnots[span + 1 - j];
+        right[j] = flatKnots[span + j] - u;
+        double saved = 0.;
+        for (int r = 0; r < j; ++r) {
+            const double temp = N[r] / (right[r + 1] + left[j - r]);
+            N[r] = saved + right[r + 1] * temp;
+            saved = left[j - r] * temp;
+        }
+        N[j] = saved;
+    }
+}
+
+void BasisFunctionsAndDerivatives(int degree, int span, double u, const double* flatKnots, double* N, double* dN)
+{
+    BasisFunctions(degree, span, u, flatKnots, N);
+
+    if (degree == 0) {
+        dN[0] = 0.;
+        return;
+    }
+
+    // N'_{i,p} = p/(t_{i+p} - t_i) * N_{i,p-1} - p/(t_{i+p+1} - t_{i+1}) * N_{i+1,p-1}
+    // The basis functions of degree p-1 span-p+1, ..., span are non-zero.
+    double Nlow[MAX_DEGREE + 1];
+    BasisFunctions(degree - 1, span, u, flatKnots, Nlow);
+
+    for (int k = 0; k <= degree; ++k) {
+        const int i = span - degree + k;
+        double d = 0.;
+        if (k > 0) {
+            const double denom = flatKnots[i + degree] - flatKnots[i];
+            if (denom > 0.) {
+                d += Nlow[k - 1] / denom;
+            }
+        }
+        if (k < degree) {
+            const double denom = flatKnots[i + degree + 1] - flatKnots[i + 1];
+            if (denom > 0.) {
+                d -= Nlow[k] / denom;
+            }
+        }
+        dN[k] = degree * d;
+    }
+}
+
+} // namespace bspline
+
+BSplineCurveEvaluator::BSplineCurveEvaluator(const Handle(Geom_BSplineCurve)& curve)
+{
+    if (curve.IsNull()) {
+        throw Error("Null Pointer curve in BSplineCurveEvaluator", geoml::NULL_POINTER);
+    }
+
+    Handle(Geom_BSplineCurve) c = curve;
+    if (c->IsPeriodic()) {
+        c = Handle(Geom_BSplineCurve)::DownCast(curve->Copy());
+        c->SetNotPeriodic();
+    }
+
+    m_degree = c->Degree();
+    m_nPoles = c->NbPoles();
+    m_knots = flatKnots(c->KnotSequence());
+
+    m_poles.resize(4 * static_cast<size_t>(m_nPoles));
+    for (int i = 1; i <= m_nPoles; ++i) {
+        const gp_Pnt& p = c->Pole(i);
+        const double w = c->Weight(i);
+        double* pole = &m_poles[4 * static_cast<size_t>(i - 1)];
+        pole[0] = p.X() * w;
+        pole[1] = p.Y() * w;
+        pole[2] = p.Z() * w;
+        pole[3] = w;
+    }
+}
+
+template <int Degree>
+gp_Pnt BSplineCurveEvaluator::value(double u) const
+{
+    const int span = bspline::FindSpan(Degree, m_nPoles, m_knots.data(), u);
+    return bspline::CurvePoint<Degree>(span, u, m_knots.data(), m_poles.data());
+}
+
+gp_Pnt BSplineCurveEvaluator::valueGeneric(double u) const
+{
+    const int span = bspline::FindSpan(m_degree, m_nPoles, m_knots.data(), u);
+
+    double N[bspline::MAX_DEGREE + 1];
+    bspline::BasisFunctions(m_degree, span, u, m_knots.data(), N);
+
+    double p[4] = {0., 0., 0., 0.};
+    const double* pole = m_poles.data() + 4 * (span - m_degree);
+    for (int k = 0; k <= m_degree; ++k, pole += 4) {
+        for (int c = 0; c < 4; ++c) {
+            p[c] += N[k] * pole[c];
+        }
+    }
+    return gp_Pnt(p[0] / p[3], p[1] / p[3], p[2] / p[3]);
+}
+
+gp_Pnt BSplineCurveEvaluator::Value(double u) const
+{
+    switch (m_degree) {
+    case 1:
+        return value<1>(u);
+    case 2:
+        return value<2>(u);
+    case 3:
+        return value<3>(u);
+    case 4:
+        return value<4>(u);
+    case 5:
+        return value<5>(u);
+    default:
+        return valueGeneric(u);
+    }
+}
+
+std::vector<gp_Pnt> BSplineCurveEvaluator::Values(const std::vector<double>& params) const
+{
+    std::vector<gp_Pnt> result;
+    result.reserve(params.size());
+    for (double u : params) {
+        result.push_back(Value(u));
+    }
+    return result;
+}
+
+BSplineSurfaceEvaluator::BSplineSurfaceEvaluator(const Handle(Geom_BSplineSurface)& surface)
+{
+    if (surface.IsNull()) {
+        throw Error("Null Pointer surface in BSplineSurfaceEvaluator", geoml::NULL_POINTER);
+    }
+
+    Handle(Geom_BSplineSurface) s = surface;
+    if (s->IsUPeriodic() || s->IsVPeriodic()) {
+        s = Handle(Geom_BSplineSurface)::DownCast(surface->Copy());
+        s->SetUNotPeriodic();
+        s->SetVNotPeriodic();
+    }
+
+    m_uDegree = s->UDegree();
+    m_vDegree = s->VDegree();
+    m_nUPoles = s->NbUPoles();
+    m_nVPoles = s->NbVPoles();
+    m_uKnots = flatKnots(s->UKnotSequence());
+    m_vKnots = flatKnots(s->VKnotSequence());
+
+    m_poles.resize(4 * static_cast<size_t>(m_nUPoles) * static_cast<size_t>(m_nVPoles));
+    for (int i = 1; i <= m_nUPoles; ++i) {
+        for (int j = 1; j <= m_nVPoles; ++j) {
+            const gp_Pnt& p = s->Pole(i, j);
+            const double w = s->Weight(i, j);
+            double* pole = &m_poles[4 * (static_cast<size_t>(i - 1) * static_cast<size_t>(m_nVPoles) + static_cast<size_t>(j - 1))];
+            pole[0] = p.X() * w;
+            pole[1] = p.Y() * w;
+            pole[2] = p.Z() * w;
+            pole[3] = w;
+        }
+    }
+}
+
+template <int UDegree, int VDegree>
+gp_Pnt BSplineSurfaceEvaluator::value(double u, double v) const
+{
+    const int uspan = bspline::FindSpan(UDegree, m_nUPoles, m_uKnots.data(), u);
+    const int vspan = bspline::FindSpan(VDegree, m_nVPoles, m_vKnots.data(), v);
+    return bspline::SurfacePoint<UDegree, VDegree>(uspan, u, m_uKnots.data(), vspan, v, m_vKnots.data(), m_poles.data(), m_nVPoles);
+}
+
+gp_Pnt BSplineSurfaceEvaluator::valueGeneric(double u, double v) const
+{
+    const int uspan = bspline::FindSpan(m_uDegree, m_nUPoles, m_uKnots.data(), u);
+    const int vspan = bspline::FindSpan(m_vDegree, m_nVPoles, m_vKnots.data(), v);
+
+    double Nu[bspline::MAX_DEGREE + 1];
+    double Nv[bspline::MAX_DEGREE + 1];
+    bspline::BasisFunctions(m_uDegree, uspan, u, m_uKnots.data(), Nu);
+    bspline::BasisFunctions(m_vDegree, vspan, v, m_vKnots.data(), Nv);
+
+    double p[4] = {0., 0., 0., 0.};
+    for (int k = 0; k <= m_uDegree; ++k) {
+        double q[4] = {0., 0., 0., 0.};
+        const double* pole = m_poles.data() + 4 * ((uspan - m_uDegree + k) * m_nVPoles + vspan - m_vDegree);
+        for (int l = 0; l <= m_vDegree; ++l, pole += 4) {
+            for (int c = 0; c < 4; ++c) {
+                q[c] += Nv[l] * pole[c];
+            }
+        }
+        for (int c = 0; c < 4; ++c) {
+            p[c] += Nu[k] * q[c];
+        }
+    }
+    return gp_Pnt(p[0] / p[3], p[1] / p[3], p[2] / p[3]);
+}
+
+gp_Pnt BSplineSurfaceEvaluator::Value(double u, double v) const
+{
+    if (m_uDegree > 3 || m_vDegree > 3) {
+        return valueGeneric(u, v);
+    }
+
+    // dispatch to the kernel specialized for the degrees
+    switch (10 * m_uDegree + m_vDegree) {
+    case 11:
+        return value<1, 1>(u, v);
+    case 12:
+        return value<1, 2>(u, v);
+    case 13:
+        return value<1, 3>(u, v);
+    case 21:
+        return value<2, 1>(u, v);
+    case 22:
+        return value<2, 2>(u, v);
+    case 23:
+        return value<2, 3>(u, v);
+    case 31:
+        return value<3, 1>(u, v);
+    case 32:
+        return value<3, 2>(u, v);
+    case 33:
+        return value<3, 3>(u, v);
+    default:
+        return valueGeneric(u, v);
+    }
+}
+
+SurfaceGridValues BSplineSurfaceEvaluator::EvaluateGrid(const std::vector<double>& u, const std::vector<double>& v,
+                                                        bool derivatives, bool normals) const
+{
+    // normals require the derivatives
+    const bool computeDerivatives = derivatives || normals;
+
+    SurfaceGridValues result;
+    result.nu = static_cast<int>(u.size());
+    result.nv = static_cast<int>(v.size());
+
+    const size_t n = u.size() * v.size();
+    result.x.resize(n);
+    result.y.resize(n);
+    result.z.resize(n);
+    if (derivatives) {
+        result.du_x.resize(n);
+        result.du_y.resize(n);
+        result.du_z.resize(n);
+        result.dv_x.resize(n);
+        result.dv_y.resize(n);
+        result.dv_z.resize(n);
+    }
+    if (normals) {
+        result.normal_x.resize(n);
+        result.normal_y.resize(n);
+        result.normal_z.resize(n);
+    }
+
+    // basis functions in v direction, computed once per v parameter
+    const size_t pv = static_cast<size_t>(m_vDegree + 1);
+    std::vector<int> vspans(v.size());
+    std::vector<double> Nv(v.size() * pv);
+    std::vector<double> dNv(computeDerivatives ? v.size() * pv : 0);
+    for (size_t j = 0; j < v.size(); ++j) {
+        vspans[j] = bspline::FindSpan(m_vDegree, m_nVPoles, m_vKnots.data(), v[j]);
+        if (computeDerivatives) {
+            bspline::BasisFunctionsAndDerivatives(m_vDegree, vspans[j], v[j], m_vKnots.data(), &Nv[j * pv], &dNv[j * pv]);
+        }
+        else {
+            bspline::BasisFunctions(m_vDegree, vspans[j], v[j], m_vKnots.data(), &Nv[j * pv]);
+        }
+    }
+
+    // homogeneous poles contracted in u direction, i.e. the poles of the iso-curve at u
+    const size_t nvPoles = static_cast<size_t>(m_nVPoles);
+    std::vector<double> Q(4 * nvPoles);
+    std::vector<double> dQ(computeDerivatives ? 4 * nvPoles : 0);
+
+    double Nu[bspline::MAX_DEGREE + 1];
+    double dNu[bspline::MAX_DEGREE + 1];
+
+    for (size_t i = 0; i < u.size(); ++i) {
+        const int uspan = bspline::FindSpan(m_uDegree, m_nUPoles, m_uKnots.data(), u[i]);
+        if (computeDerivatives) {
+            bspline::BasisFunctionsAndDerivatives(m_uDegree, uspan, u[i], m_uKnots.data(), Nu, dNu);
+        }
+        else {
+            bspline::BasisFunctions(m_uDegree, uspan, u[i], m_uKnots.data(), Nu);
+        }
+
+        std::fill(Q.begin(), Q.end(), 0.);
+        std::fill(dQ.begin(), dQ.end(), 0.);
+        for (int k = 0; k <= m_uDegree; ++k) {
+            const double* row = &m_poles[4 * static_cast<size_t>(uspan - m_uDegree + k) * nvPoles];
+            const double nu = Nu[k];
+            for (size_t l = 0; l < 4 * nvPoles; ++l) {
+                Q[l] += nu * row[l];
+            }
+            if (computeDerivatives) {
+                const double dnu = dNu[k];
+                for (size_t l = 0; l < 4 * nvPoles; ++l) {
+                    dQ[l] += dnu * row[l];
+                }
+            }
+        }
+
+        for (size_t j = 0; j < v.size(); ++j) {
+            const size_t first = 4 * static_cast<size_t>(vspans[j] - m_vDegree);
+            const double* nv = &Nv[j * pv];
+
+            // homogeneous point A and weight w
+            double A[4] = {0., 0., 0., 0.};
+            for (size_t l = 0; l < pv; ++l) {
+                for (int c = 0; c < 4; ++c) {
+                    A[c] += nv[l] * Q[first + 4 * l + c];
+                }
+            }
+
+            const double w = A[3];
+            const double S[3] = {A[0] / w, A[1] / w, A[2] / w};
+            const size_t idx = i * v.size() + j;
+            result.x[idx] = S[0];
+            result.y[idx] = S[1];
+            result.z[idx] = S[2];
+
+            if (!computeDerivatives) {
+                continue;
+            }
+
+            const double* dnv = &dNv[j * pv];
+            double Au[4] = {0., 0., 0., 0.};
+            double Av[4] = {0., 0., 0., 0.};
+            for (size_t l = 0; l < pv; ++l) {
+                for (int c = 0; c < 4; ++c) {
+                    Au[c] += nv[l] * dQ[first + 4 * l + c];
+                    Av[c] += dnv[l] * Q[first + 4 * l + c];
+                }
+            }
+
+            // derivatives of the rational surface S = A/w
+            double Su[3], Sv[3];
+            for (int c = 0; c < 3; ++c) {
+                Su[c] = (Au[c] - Au[3] * S[c]) / w;
+                Sv[c] = (Av[c] - Av[3] * S[c]) / w;
+            }
+
+            if (derivatives) {
+                result.du_x[idx] = Su[0];
+                result.du_y[idx] = Su[1];
+                result.du_z[idx] = Su[2];
+                result.dv_x[idx] = Sv[0];
+                result.dv_y[idx] = Sv[1];
+                result.dv_z[idx] = Sv[2];
+            }
+
+            if (normals) {
+                double nx = Su[1] * Sv[2] - Su[2] * Sv[1];
+                double ny = Su[2] * Sv[0] - Su[0] * Sv[2];
+                double nz = Su[0] * Sv[1] - Su[1] * Sv[0];
+                const double len = std::sqrt(nx * nx + ny * ny + nz * nz);
+                if (len > 0.) {
+                    nx /= len;
+                    ny /= len;
+                    nz /= len;
+                }
+                result.normal_x[idx] = nx;
+                result.normal_y[idx] = ny;
+                result.normal_z[idx] = nz;
+            }
+        }
+    }
+
+    return result;
+}
+
+} // namespace geoml
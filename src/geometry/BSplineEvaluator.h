@@ -0,0 +1,237 @@
+/*
+* Copyright (C) 2026 German Aerospace Center (DLR/SC)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#pragma once
+
+#include "geoml_internal.h"
+#include "geoml/surfaces/SurfaceGridValues.h"
+
+#include <Geom_BSplineCurve.hxx>
+#include <Geom_BSplineSurface.hxx>
+#include <gp_Pnt.hxx>
+
+#include <vector>
+
+namespace geoml
+{
+
+namespace bspline
+{
+
+/// Maximum degree supported by the evaluation kernels (same as OCCT)
+const int MAX_DEGREE = 25;
+
+/**
+ * @brief Returns the knot span index of the parameter u
+ *
+ * The span i satisfies flatKnots[i] <= u < flatKnots[i+1] and is clamped to
+ * [degree, nPoles-1], i.e. parameters outside the curve range are evaluated
+ * by extrapolation of the first or last segment. Indices start at 0.
+ */
+GEOML_EXPORT int FindSpan(int degree, int nPoles, const double* flatKnots, double u);
+
+/**
+ * @brief Computes the degree+1 non-vanishing basis functions at u
+ *
+ * Implements algorithm A2.2 of Piegl and Tiller, The NURBS Book.
+ * As the degree is a compile time constant, all loops can be unrolled
+ * by the compiler.
+ *
+ * @param span      Knot span of u as returned by FindSpan
+ * @param u         Parameter
+ * @param flatKnots Flat knot vector, indices start at 0
+ * @param N         Output, the values of the basis functions span-Degree, ..., span
+ */
+template <int Degree>
+inline void BasisFunctions(int span, double u, const double* flatKnots, double* N)
+{
+    double left[Degree + 1];
+    double right[Degree + 1];
+    N[0] = 1.;
+    for (int j = 1; j <= Degree; ++j) {
+        left[j] = u - flatKnots[span + 1 - j];
+        right[j] = flatKnots[span + j] - u;
+        double saved = 0.;
+        for (int r = 0; r < j; ++r) {
+            const double temp = N[r] / (right[r + 1] + left[j - r]);
+            N[r] = saved + right[r + 1] * temp;
+            saved = left[j - r] * temp;
+        }
+        N[j] = saved;
+    }
+}
+
+/// Same as BasisFunctions<Degree>, but with the degree given at runtime.
+/// Dispatches to the specialized kernels for degrees 1 to 5.
+GEOML_EXPORT void BasisFunctions(int degree, int span, double u, const double* flatKnots, double* N);
+
+/**
+ * @brief Computes the degree+1 non-vanishing basis functions and their first derivatives at u
+ *
+ * @param N  Output, the values of the basis functions span-degree, ..., span
+ * @param dN Output, the first derivatives of the basis functions span-degree, ..., span
+ */
+GEOML_EXPORT void BasisFunctionsAndDerivatives(int degree, int span, double u, const double* flatKnots, double* N, double* dN);
+
+/**
+ * @brief Evaluates a curve segment from homogeneous poles (x*w, y*w, z*w, w)
+ *
+ * @param span  Knot span of u as returned by FindSpan
+ * @param poles Homogeneous poles, 4 values per pole
+ */
+template <int Degree>
+inline gp_Pnt CurvePoint(int span, double u, const double* flatKnots, const double* poles)
+{
+    double N[Degree + 1];
+    BasisFunctions<Degree>(span, u, flatKnots, N);
+
+    double p[4] = {0., 0., 0., 0.};
+    const double* pole = poles + 4 * (span - Degree);
+    for (int k = 0; k <= Degree; ++k, pole += 4) {
+        for (int c = 0; c < 4; ++c) {
+            p[c] += N[k] * pole[c];
+        }
+    }
+    return gp_Pnt(p[0] / p[3], p[1] / p[3], p[2] / p[3]);
+}
+
+/**
+ * @brief Evaluates a surface patch from homogeneous poles (x*w, y*w, z*w, w)
+ *
+ * @param poles  Homogeneous poles, 4 values per pole. The pole (i,j) is stored at 4*(i*nVPoles + j)
+ */
+template <int UDegree, int VDegree>
+inline gp_Pnt SurfacePoint(int uspan, double u, const double* uFlatKnots,
+                           int vspan, double v, const double* vFlatKnots,
+                           const double* poles, int nVPoles)
+{
+    double Nu[UDegree + 1];
+    double Nv[VDegree + 1];
+    BasisFunctions<UDegree>(uspan, u, uFlatKnots, Nu);
+    BasisFunctions<VDegree>(vspan, v, vFlatKnots, Nv);
+
+    double p[4] = {0., 0., 0., 0.};
+    for (int k = 0; k <= UDegree; ++k) {
+        // de Boor in v-direction for the u-row k
+        double q[4] = {0., 0., 0., 0.};
+        const double* pole = poles + 4 * ((uspan - UDegree + k) * nVPoles + vspan - VDegree);
+        for (int l = 0; l <= VDegree; ++l, pole += 4) {
+            for (int c = 0; c < 4; ++c) {
+                q[c] += Nv[l] * pole[c];
+            }
+        }
+        for (int c = 0; c < 4; ++c) {
+            p[c] += Nu[k] * q[c];
+        }
+    }
+    return gp_Pnt(p[0] / p[3], p[1] / p[3], p[2] / p[3]);
+}
+
+} // namespace bspline
+
+/**
+ * @brief Fast point evaluation of a B-spline curve
+ *
+ * Copies the knots and poles of the curve into contiguous arrays and
+ * evaluates using kernels that are specialized at compile time for
+ * degrees 1 to 5. Other degrees are evaluated by a generic kernel.
+ *
+ * This should be used instead of Geom_BSplineCurve::Value, if many points
+ * of the same curve are evaluated.
+ */
+class BSplineCurveEvaluator
+{
+public:
+    GEOML_EXPORT explicit BSplineCurveEvaluator(const Handle(Geom_BSplineCurve)& curve);
+
+    /// Returns the curve point at parameter u
+    GEOML_EXPORT gp_Pnt Value(double u) const;
+
+    /// Returns the curve points at all given parameters
+    GEOML_EXPORT std::vector<gp_Pnt> Values(const std::vector<double>& params) const;
+
+    int Degree() const
+    {
+        return m_degree;
+    }
+
+private:
+    template <int Degree>
+    gp_Pnt value(double u) const;
+
+    gp_Pnt valueGeneric(double u) const;
+
+    int m_degree;
+    int m_nPoles;
+    std::vector<double> m_knots;
+    std::vector<double> m_poles;
+};
+
+/**
+ * @brief Fast point evaluation of a B-spline surface
+ *
+ * Same as BSplineCurveEvaluator for surfaces. The kernels are specialized
+ * for all combinations of the degrees 1 to 3.
+ */
+class BSplineSurfaceEvaluator
+{
+public:
+    GEOML_EXPORT explicit BSplineSurfaceEvaluator(const Handle(Geom_BSplineSurface)& surface);
+
+    /// Returns the surface point at the parameters (u, v)
+    GEOML_EXPORT gp_Pnt Value(double u, double v) const;
+
+    /**
+     * @brief Evaluates the surface on the tensor product grid of the u and v parameters
+     *
+     * The basis functions are computed only once per u and v parameter and
+     * the poles are contracted in u direction once per u parameter. Hence,
+     * a grid of N x M points requires O(N + M) basis evaluations.
+     *
+     * @param u           The u parameters of the grid
+     * @param v           The v parameters of the grid
+     * @param derivatives If true, the first derivatives are computed as well
+     * @param normals     If true, the unit normals are computed as well
+     */
+    GEOML_EXPORT SurfaceGridValues EvaluateGrid(const std::vector<double>& u, const std::vector<double>& v,
+                                                bool derivatives = false, bool normals = false) const;
+
+    int UDegree() const
+    {
+        return m_uDegree;
+    }
+
+    int VDegree() const
+    {
+        return m_vDegree;
+    }
+
+private:
+    template <int UDegree, int VDegree>
+    gp_Pnt value(double u, double v) const;
+
+    gp_Pnt valueGeneric(double u, double v) const;
+
+    int m_uDegree;
+    int m_vDegree;
+    int m_nUPoles;
+    int m_nVPoles;
+    std::vector<double> m_uKnots;
+    std::vector<double> m_vKnots;
+    std::vector<double> m_poles;
+};
+
+} // namespace geoml
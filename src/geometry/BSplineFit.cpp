@@ -15,14 +15,13 @@
  */
 
 #include "BSplineFit.h"
+#include "BSplineBasisMatrix.h"
+#include "math/BandedMatrix.h"
 
-#include <Standard_Version.hxx>
 #include <TColStd_Array1OfReal.hxx>
 #include <TColStd_Array1OfInteger.hxx>
 #include <math_Matrix.hxx>
-#include <math_Gauss.hxx>
 
-#include <BSplCLib.hxx>
 #include <Geom_BSplineCurve.hxx>
 
 #include <iostream>
@@ -68,75 +67,55 @@ void BSplineFit::copyPoints( const TColgp_Array1OfPnt& points )
 /**
  * @brief Initializes linear equation system for least square fit
  */
-void BSplineFit::initSystem(math_Matrix& A, math_Vector& rhsx, math_Vector& rhsy, math_Vector& rhsz)
+void BSplineFit::initSystem(geoml::SymmetricBandedMatrix& A, math_Matrix& rhs)
 {
 
-    // init matrices and vectors
-    A.Init(0.);
-    rhsx.Init(0.);
-    rhsy.Init(0.);
-    rhsz.Init(0.);
+    // init right hand side, the columns are the x, y and z coordinates
+    rhs.Init(0.);
 
-    int n_vars = rhsx.Length();
+    int n_vars = rhs.RowNumber();
 
     // order of the B-spline system
     int order = _degree + 1;
 
-    math_Matrix bspl_basis(1, 1, 1, order);
-
-    const size_t nPoints = _px.size();
+    geoml::BSplineBasisMatrix basis(_degree, _knots, t);
 
     // loop over all curve points which have to be fitted
-    for (size_t k=0; k<nPoints; ++k ) {
-
-        // set curve parameter
-        double tk = t[k];
+    for (int k=1; k<=basis.RowNumber(); ++k ) {
 
-        int basis_start_index;
-#if OCC_VERSION_HEX >= VERSION_HEX_CODE(7,1,0)
-        BSplCLib::EvalBsplineBasis(0, order, _knots, tk, basis_start_index, bspl_basis);
-#else
-        BSplCLib::EvalBsplineBasis(1, 0, order, _knots, tk, basis_start_index, bspl_basis);
-#endif
-        basis_start_index--;
-
-        int start = std::max(1, basis_start_index);
-        int stop  = std::min(n_vars + 1, max(1, basis_start_index + order));
+        // the first and last control point are not part of the system,
+        // hence column i of the basis matrix belongs to variable i-1
+        int basis_start_index = basis.RowStart(k) - 1;
+        const double* values = basis.RowValues(k);
 
         // first and last basis element
-        double N0 = 0.;
-        double N1 = 0.;
-
-        if (basis_start_index == 0) {
-            N0 = bspl_basis.Value(1,1);
-        }
+        double N0 = basis.Value(k, 1);
+        double N1 = basis.Value(k, _ncp);
 
-        if (basis_start_index >= _ncp-order) {
-            N1 = bspl_basis.Value(1, order);
-        }
+        // right hand side - the interpolation of end points is taken care of
+        const double b[3] = {
+            _px[k-1] - _px.front() * N0 - _px.back() * N1,
+            _py[k-1] - _py.front() * N0 - _py.back() * N1,
+            _pz[k-1] - _pz.front() * N0 - _pz.back() * N1
+        };
+
+        for (int i=0; i < order; ++i ) {
+            int row = basis_start_index + i;
+            if (row < 1 || row > n_vars) {
+                continue;
+            }
 
-        // compute matrix values
-        for (int i=start; i < stop; ++i ) {
-            for (int j=i; j < stop; ++j ) {
-                A(i, j) += bspl_basis.Value(1, i+1-basis_start_index)*bspl_basis.Value(1, j+1-basis_start_index);
+            // compute matrix values, only the lower band is stored
+            for (int j=i; j < order && basis_start_index + j <= n_vars; ++j ) {
+                A(basis_start_index + j, row) += values[i] * values[j];
             }
-        }
 
-        // right hand side - the interpolation of end points is taken care of
-        for (int i=start; i < stop; i++) {
-            rhsx(i) += ( _px[k] -  _px.front() * N0 - _px.back() * N1 ) * bspl_basis.Value(1,i+1-basis_start_index);
-            rhsy(i) += ( _py[k] -  _py.front() * N0 - _py.back() * N1 ) * bspl_basis.Value(1,i+1-basis_start_index);
-            rhsz(i) += ( _pz[k] -  _pz.front() * N0 - _pz.back() * N1 ) * bspl_basis.Value(1,i+1-basis_start_index);
+            for (int c=0; c < 3; ++c ) {
+                rhs(row, c+1) += b[c] * values[i];
+            }
         }
 
     } //  loop over all curve points
-
-    // symmetrize the matrix of the LES
-    for (int i=2; i <= n_vars; ++i ) {
-        for (int j=1; j < i; ++j ) {
-            A(i, j) = A(j, i);
-        }
-    }
 }
 
 
@@ -390,41 +369,25 @@ BSplineFit::error BSplineFit::fitCurve()
     // want to interpolate them
     int n_vars = _ncp - 2;
 
-    // solution of the solver
-    math_Vector X(1,n_vars);
-    math_Vector Y(1,n_vars);
-    math_Vector Z(1,n_vars);
-
-    // rhs of the solver
-    math_Vector cx(1,n_vars);
-    math_Vector cy(1,n_vars);
-    math_Vector cz(1,n_vars);
-
-    math_Matrix A(1, n_vars, 1, n_vars);
-
-    initSystem(A, cx, cy, cz);
+    if (n_vars > 0) {
+        // right hand side and solution of the solver
+        math_Matrix X(1, n_vars, 1, 3);
 
-    math_Gauss solver(A);
+        // the least squares matrix is a band matrix with bandwidth degree
+        geoml::SymmetricBandedMatrix A(n_vars, _degree);
 
-    solver.Solve(cx, X);
-    if (!solver.IsDone()) {
-        return MatrixSingular;
-    }
-
-    solver.Solve(cy, Y);
-    if (!solver.IsDone()) {
-        return MatrixSingular;
-    }
+        initSystem(A, X);
 
-    solver.Solve(cz, Z);
-    if (!solver.IsDone()) {
-        return MatrixSingular;
-    }
+        if (!A.Factorize()) {
+            return MatrixSingular;
+        }
+        A.Solve(X);
 
-    // copy solution to control point vector
-    for (int i=1; i<_ncp-1; ++i ) {
-        gp_Pnt p(X(i), Y(i), Z(i));
-        poles.SetValue(i+1, p);
+        // copy solution to control point vector
+        for (int i=1; i<_ncp-1; ++i ) {
+            gp_Pnt p(X(i, 1), X(i, 2), X(i, 3));
+            poles.SetValue(i+1, p);
+        }
     }
 
     _curve = new Geom_BSplineCurve(poles, knots_compact, mults, _degree);
@@ -24,6 +24,11 @@
 #include <Geom_BSplineCurve.hxx>
 #include <TColgp_Array1OfPnt.hxx>
 
+namespace geoml
+{
+class SymmetricBandedMatrix;
+}
+
 class BSplineFit
 {
 
@@ -69,7 +74,7 @@ private:
 
 
     /// Computes the matrix and the right hand side of the system to be solved
-    void initSystem(class math_Matrix& A, class math_Vector& rhsx, class math_Vector& rhsy, class math_Vector& rhsz);
+    void initSystem(geoml::SymmetricBandedMatrix& A, class math_Matrix& rhs);
 
     /// Computes an uniform knot vector
     void computeKnots();
@@ -17,6 +17,9 @@
 #include "CompoundSurface.h"
 
 #include "geoml/error.h"
+
+#include <Geom_BSplineSurface.hxx>
+
 #include <algorithm>
 
 namespace geoml
@@ -33,6 +36,17 @@ CompoundSurface::CompoundSurface(const std::vector<Handle(Geom_BoundedSurface)>&
     if (!std::is_sorted(std::begin(m_uparams), std::end(m_uparams))) {
         throw Error("Parameters not sorted in CompoundSurface");
     }
+
+    // B-spline surfaces are evaluated with the fast evaluator
+    for (const auto& surface : m_surfaces) {
+        Handle(Geom_BSplineSurface) bspl = Handle(Geom_BSplineSurface)::DownCast(surface);
+        if (!bspl.IsNull()) {
+            m_evaluators.push_back(std::make_shared<BSplineSurfaceEvaluator>(bspl));
+        }
+        else {
+            m_evaluators.push_back(nullptr);
+        }
+    }
 }
 
 gp_Pnt CompoundSurface::Value(double u, double v) const
@@ -47,6 +61,9 @@ gp_Pnt CompoundSurface::Value(double u, double v) const
 
             double us = u1 + (u - m_uparams[idx])/(m_uparams[idx+1]-m_uparams[idx])*(u2 - u1);
             double vs = (1.-v) * v1 + v*v2;
+            if (m_evaluators[idx]) {
+                return m_evaluators[idx]->Value(us, vs);
+            }
             return surface->Value(us, vs);
         }
     }
@@ -18,9 +18,11 @@
 #define COMPOUNDSURFACE_H
 
 #include "geoml_internal.h"
+#include "BSplineEvaluator.h"
 
 #include <gp_Pnt.hxx>
 #include <Geom_BoundedSurface.hxx>
+#include <memory>
 #include <vector>
 
 namespace geoml
@@ -45,6 +47,9 @@ public:
 private:
     std::vector<Handle(Geom_BoundedSurface)> m_surfaces;
     std::vector<double> m_uparams;
+
+    /// Fast evaluators of the surfaces, null if the surface is not a B-spline
+    std::vector<std::shared_ptr<BSplineSurfaceEvaluator>> m_evaluators;
 };
 
 } // namespace geoml
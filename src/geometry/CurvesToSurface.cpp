@@ -140,16 +140,21 @@ GEOML_EXPORT void CurvesToSurface::Perform()
 
     // create matrix of new control points with size which is possibly DIFFERENT from the size of controlPoints
     Handle(TColgp_HArray2OfPnt) cpSurf;
-    Handle(TColgp_HArray1OfPnt) interpPointsVDir = new TColgp_HArray1OfPnt(1, static_cast<Standard_Integer>(nCurves));
-
-    // now continue to create new control points by interpolating the remaining columns of controlPoints in Skinning direction (here v-direction) by B-splines
+    std::vector<Handle(TColgp_HArray1OfPnt)> interpPointsVDir(numControlPointsU);
     for (int cpUIdx = 1; cpUIdx <= numControlPointsU; ++cpUIdx) {
+        interpPointsVDir[cpUIdx - 1] = new TColgp_HArray1OfPnt(1, static_cast<Standard_Integer>(nCurves));
         for (int cpVIdx = 1; cpVIdx <= nCurves; ++cpVIdx) {
-            interpPointsVDir->SetValue(cpVIdx, _compatibleSplines[cpVIdx - 1]->Pole(cpUIdx));
+            interpPointsVDir[cpUIdx - 1]->SetValue(cpVIdx, _compatibleSplines[cpVIdx - 1]->Pole(cpUIdx));
         }
+    }
 
-        PointsToBSplineInterpolation interpol(interpPointsVDir, _parameters, _maxDegree, makeClosed);
-        Handle(Geom_BSplineCurve) interpSpline = interpol.Curve();
+    // now continue to create new control points by interpolating the remaining columns of controlPoints in Skinning direction (here v-direction) by B-splines.
+    // All columns share the same parameters, hence the interpolation system is factorized only once.
+    std::vector<Handle(Geom_BSplineCurve)> interpSplines =
+        PointsToBSplineInterpolation::Curves(interpPointsVDir, _parameters, _maxDegree, makeClosed);
+
+    for (int cpUIdx = 1; cpUIdx <= numControlPointsU; ++cpUIdx) {
+        Handle(Geom_BSplineCurve)& interpSpline = interpSplines[cpUIdx - 1];
 
         if (makeClosed) {
             clampBSpline(interpSpline);
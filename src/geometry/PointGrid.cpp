@@ -0,0 +1,51 @@
+/*
+* Copyright (C) 2026 German Aerospace Center (DLR/SC)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "PointGrid.h"
+
+#include "geoml/error.h"
+
+#include <algorithm>
+
+namespace geoml
+{
+
+PointGrid::PointGrid(const std::vector<gp_Pnt>& points, double cellSize)
+    : m_points(points)
+    , m_cellSize(cellSize)
+{
+    if (!(cellSize > 0.)) {
+        throw Error("The cell size of a PointGrid must be positive", MATH_ERROR);
+    }
+
+    m_cells.reserve(points.size());
+    for (size_t i = 0; i < m_points.size(); ++i) {
+        const gp_Pnt& p = m_points[i];
+        m_cells[key(cell(p.X()), cell(p.Y()), cell(p.Z()))].push_back(i);
+    }
+}
+
+std::vector<size_t> PointGrid::Neighbors(const gp_Pnt& p, double radius) const
+{
+    std::vector<size_t> result;
+    ForEachNeighbor(p, radius, [&result](size_t index) {
+        result.push_back(index);
+    });
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+} // namespace geoml
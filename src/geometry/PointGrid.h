@@ -0,0 +1,100 @@
+/*
+* Copyright (C) 2026 German Aerospace Center (DLR/SC)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#pragma once
+
+#include "geoml_internal.h"
+
+#include <gp_Pnt.hxx>
+
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace geoml
+{
+
+/**
+ * @brief Uniform grid of points for neighbor queries
+ *
+ * The points are sorted into cubic cells of a given size. A query with a
+ * radius r only visits the cells within r around the query point. Hence, a
+ * query costs O(1) on average, if the radius is about the cell size.
+ */
+class PointGrid
+{
+public:
+    /**
+     * @param points   The indexed points. The grid refers to them by their index.
+     * @param cellSize Edge length of the cells, usually the query radius
+     */
+    GEOML_EXPORT PointGrid(const std::vector<gp_Pnt>& points, double cellSize);
+
+    /**
+     * @brief Calls f(index) for all points with a distance < radius to p
+     *
+     * The points are visited in no particular order.
+     */
+    template <typename Func>
+    void ForEachNeighbor(const gp_Pnt& p, double radius, Func&& f) const
+    {
+        const int64_t r = static_cast<int64_t>(std::ceil(radius / m_cellSize));
+        const int64_t cx = cell(p.X()), cy = cell(p.Y()), cz = cell(p.Z());
+        const double radius2 = radius * radius;
+
+        for (int64_t ix = cx - r; ix <= cx + r; ++ix) {
+            for (int64_t iy = cy - r; iy <= cy + r; ++iy) {
+                for (int64_t iz = cz - r; iz <= cz + r; ++iz) {
+                    auto it = m_cells.find(key(ix, iy, iz));
+                    if (it == m_cells.end()) {
+                        continue;
+                    }
+                    for (size_t index : it->second) {
+                        if (m_points[index].SquareDistance(p) < radius2) {
+                            f(index);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    /// Returns the indices of all points with a distance < radius to p in ascending order
+    GEOML_EXPORT std::vector<size_t> Neighbors(const gp_Pnt& p, double radius) const;
+
+private:
+    int64_t cell(double x) const
+    {
+        return static_cast<int64_t>(std::floor(x / m_cellSize));
+    }
+
+    static uint64_t key(int64_t ix, int64_t iy, int64_t iz)
+    {
+        // 21 bits per coordinate. Distant cells might share a key, which only
+        // adds candidates that are rejected by the distance check.
+        const uint64_t mask = (uint64_t(1) << 21) - 1;
+        return ((static_cast<uint64_t>(ix) & mask) << 42) |
+               ((static_cast<uint64_t>(iy) & mask) << 21) |
+                (static_cast<uint64_t>(iz) & mask);
+    }
+
+    std::vector<gp_Pnt> m_points;
+    double m_cellSize;
+    std::unordered_map<uint64_t, std::vector<size_t>> m_cells;
+};
+
+} // namespace geoml
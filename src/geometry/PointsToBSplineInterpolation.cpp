@@ -20,14 +20,20 @@
 
 #include "geoml/error.h"
 #include "BSplineAlgorithms.h"
+#include "BSplineBasisMatrix.h"
 
 #include <BSplCLib.hxx>
 #include <math_Gauss.hxx>
 #include <GeomConvert.hxx>
 #include <Geom_TrimmedCurve.hxx>
 
+#include <OSD_Parallel.hxx>
+
 #include <algorithm>
 #include <cassert>
+#include <exception>
+#include <memory>
+#include <string>
 
 namespace
 {
@@ -50,6 +56,140 @@ void clamp(Handle(Geom_BSplineCurve) & curve, double min, double max)
     curve                = GeomConvert::CurveToBSplineCurve(c);
 }
 
+/**
+ * @brief The linear system of the interpolation
+ *
+ * It only depends on the parameters, the degree and whether the curve is closed.
+ * The system is factorized once and can then be solved for several point sets.
+ */
+class InterpolationSystem
+{
+public:
+    InterpolationSystem(const std::vector<double>& parameters, int degree, bool closed)
+        : m_params(parameters)
+        , m_degree(degree)
+        , m_closed(closed)
+    {
+        // the parameters might be shifted for closed curves
+        std::vector<double> params = m_params;
+        m_knots = geoml::BSplineAlgorithms::knotsFromCurveParameters(params, static_cast<unsigned int>(m_degree), m_closed);
+        m_firstParam = params.front();
+
+        if (m_closed) {
+            // we remove the last parameter, since it is implicitly
+            // included by wrapping the control points
+            params.pop_back();
+        }
+
+        geoml::BSplineBasisMatrix bsplMat(m_degree, toArray(m_knots)->Array1(), params);
+
+        // build left hand side of the linear system
+        m_nParams = static_cast<int>(params.size());
+        math_Matrix lhs(1, m_nParams, 1, m_nParams, 0.);
+        for (int iRow = 1; iRow <= m_nParams; ++iRow) {
+            const double* values = bsplMat.RowValues(iRow);
+            for (int k = 0; k < bsplMat.RowLength(); ++k) {
+                int iCol = bsplMat.RowStart(iRow) + k;
+                if (iCol > m_nParams) {
+                    // sets the continuity constraints for closed curves on the left hand side
+                    // by wrapping around the control points
+
+                    // This is a trick to make the matrix square and enforce the endpoint conditions
+                    iCol -= m_nParams;
+                }
+                lhs(iRow, iCol) += values[k];
+            }
+        }
+
+        m_solver.reset(new math_Gauss(lhs));
+        if (!m_solver->IsDone()) {
+            throw geoml::Error("Singular Matrix", geoml::MATH_ERROR);
+        }
+    }
+
+    /// Computes the interpolating curve of the given points
+    Handle(Geom_BSplineCurve) Solve(const TColgp_Array1OfPnt& points) const
+    {
+        if (points.Length() != static_cast<int>(m_params.size())) {
+            throw geoml::Error("Number of parameters and points don't match in PointsToBSplineInterpolation");
+        }
+
+        // right hand side, the columns are the x, y and z coordinates
+        math_Matrix rhs(1, m_nParams, 1, 3);
+        for (int i = 1; i <= m_nParams; ++i) {
+            const gp_Pnt& p = points.Value(points.Lower() + i - 1);
+            rhs(i, 1)       = p.X();
+            rhs(i, 2)       = p.Y();
+            rhs(i, 3)       = p.Z();
+        }
+
+        math_Matrix cp(1, m_nParams, 1, 3);
+        for (int icoord = 1; icoord <= 3; ++icoord) {
+            math_Vector cp_i(1, m_nParams);
+            m_solver->Solve(rhs.Col(icoord), cp_i);
+            cp.SetCol(icoord, cp_i);
+        }
+
+        bool needsShifting = (m_degree % 2) == 0 && m_closed;
+
+        int nCtrPnts = static_cast<int>(m_params.size());
+        if (m_closed) {
+            nCtrPnts += m_degree - 1;
+        }
+        if (needsShifting) {
+            nCtrPnts += 1;
+        }
+        TColgp_Array1OfPnt poles(1, nCtrPnts);
+        for (Standard_Integer icp = 1; icp <= m_nParams; ++icp) {
+            poles.SetValue(icp, gp_Pnt(cp(icp, 1), cp(icp, 2), cp(icp, 3)));
+        }
+
+        std::vector<double> knots = m_knots;
+        if (m_closed) {
+            // wrap control points
+            for (Standard_Integer icp = 1; icp <= m_degree; ++icp) {
+                poles.SetValue(m_nParams + icp, gp_Pnt(cp(icp, 1), cp(icp, 2), cp(icp, 3)));
+            }
+        }
+        if (needsShifting) {
+            // add a new control point and knot
+            size_t deg = static_cast<size_t>(m_degree);
+            knots.push_back(knots.back() + knots[2 * deg + 1] - knots[2 * deg]);
+            poles.SetValue(m_nParams + m_degree + 1, poles.Value(m_degree + 1));
+
+            // shift back the knots
+            for (size_t iknot = 0; iknot < knots.size(); ++iknot) {
+                knots[iknot] -= m_firstParam;
+            }
+        }
+
+        Handle(TColStd_HArray1OfReal) occFlatKnots = toArray(knots);
+        int knotsLen                               = BSplCLib::KnotsLength(occFlatKnots->Array1());
+
+        TColStd_Array1OfReal occKnots(1, knotsLen);
+        TColStd_Array1OfInteger occMults(1, knotsLen);
+        BSplCLib::Knots(occFlatKnots->Array1(), occKnots, occMults);
+
+        Handle(Geom_BSplineCurve) result = new Geom_BSplineCurve(poles, occKnots, occMults, m_degree, false);
+
+        // clamp bspline
+        if (m_closed) {
+            clamp(result, m_params.front(), m_params.back());
+        }
+
+        return result;
+    }
+
+private:
+    std::vector<double> m_params;
+    std::vector<double> m_knots;
+    int m_degree;
+    bool m_closed;
+    int m_nParams;
+    double m_firstParam;
+    std::unique_ptr<math_Gauss> m_solver;
+};
+
 } // namespace
 
 namespace geoml
@@ -103,117 +243,60 @@ PointsToBSplineInterpolation::PointsToBSplineInterpolation(const Handle(TColgp_H
 
 Handle(Geom_BSplineCurve) PointsToBSplineInterpolation::Curve() const
 {
-    int degree = static_cast<int>(Degree());
-
-    std::vector<double> params = m_params;
-
-    std::vector<double> knots =
-        BSplineAlgorithms::knotsFromCurveParameters(params, static_cast<unsigned int>(degree), isClosed());
-
-    if (isClosed()) {
-        // we remove the last parameter, since it is implicitly
-        // included by wrapping the control points
-        params.pop_back();
-    }
-
-    math_Matrix bsplMat =
-        BSplineAlgorithms::bsplineBasisMat(degree, toArray(knots)->Array1(), toArray(params)->Array1());
-
-    // build left hand side of the linear system
-    int nParams = static_cast<int>(params.size());
-    math_Matrix lhs(1, nParams, 1, nParams, 0.);
-    for (int iCol = 1; iCol <= nParams; ++iCol) {
-        lhs.SetCol(iCol, bsplMat.Col(iCol));
-    }
-    if (isClosed()) {
-        // sets the continuity constraints for closed curves on the left hand side if requested
-        // by wrapping around the control points
+    InterpolationSystem system(m_params, static_cast<int>(Degree()), isClosed());
+    return system.Solve(m_pnts->Array1());
+}
 
-        // This is a trick to make the matrix square and enforce the endpoint conditions
-        for (int iCol = 1; iCol <= degree; ++iCol) {
-            lhs.SetCol(iCol, lhs.Col(iCol) + bsplMat.Col(nParams + iCol));
+std::vector<Handle(Geom_BSplineCurve)> PointsToBSplineInterpolation::Curves(const std::vector<Handle(TColgp_HArray1OfPnt)>& pointSets,
+                                                                            const std::vector<double>& parameters,
+                                                                            unsigned int maxDegree, bool continuousIfClosed,
+                                                                            bool parallel)
+{
+    // The linear system only depends on the parameters, the degree and whether
+    // the curve is closed. Hence, we need at most two factorizations.
+    std::vector<bool> closed(pointSets.size(), false);
+    std::unique_ptr<InterpolationSystem> openSystem, closedSystem;
+    for (size_t iset = 0; iset < pointSets.size(); ++iset) {
+        if (pointSets[iset].IsNull()) {
+            throw Error("No points given in PointsToBSplineInterpolation::Curves", geoml::NULL_POINTER);
         }
-    }
-
-    // right hand side
-    math_Vector rhsx(1, nParams, 0.);
-    math_Vector rhsy(1, nParams, 0.);
-    math_Vector rhsz(1, nParams, 0.);
-    for (int i = 1; i <= nParams; ++i) {
-        const gp_Pnt& p = m_pnts->Value(i);
-        rhsx(i)         = p.X();
-        rhsy(i)         = p.Y();
-        rhsz(i)         = p.Z();
-    }
-
-    math_Gauss solver(lhs);
-
-    math_Vector cp_x(1, nParams);
-    math_Vector cp_y(1, nParams);
-    math_Vector cp_z(1, nParams);
-
-    solver.Solve(rhsx, cp_x);
-    if (!solver.IsDone()) {
-        throw Error("Singular Matrix", geoml::MATH_ERROR);
-    }
-
-    solver.Solve(rhsy, cp_y);
-    if (!solver.IsDone()) {
-        throw Error("Singular Matrix", geoml::MATH_ERROR);
-    }
 
-    solver.Solve(rhsz, cp_z);
-    if (!solver.IsDone()) {
-        throw Error("Singular Matrix", geoml::MATH_ERROR);
-    }
+        PointsToBSplineInterpolation interpolation(pointSets[iset], parameters, maxDegree, continuousIfClosed);
+        closed[iset] = interpolation.isClosed();
 
-    int nCtrPnts = static_cast<int>(m_params.size());
-    if (isClosed()) {
-        nCtrPnts += degree - 1;
-    }
-    if (needsShifting()) {
-        nCtrPnts += 1;
-    }
-    TColgp_Array1OfPnt poles(1, nCtrPnts);
-    for (Standard_Integer icp = 1; icp <= nParams; ++icp) {
-        gp_Pnt pnt(cp_x.Value(icp), cp_y.Value(icp), cp_z.Value(icp));
-        poles.SetValue(icp, pnt);
+        std::unique_ptr<InterpolationSystem>& system = closed[iset] ? closedSystem : openSystem;
+        if (!system) {
+            system.reset(new InterpolationSystem(parameters, static_cast<int>(interpolation.Degree()), closed[iset]));
+        }
     }
 
-    if (isClosed()) {
-        // wrap control points
-        for (Standard_Integer icp = 1; icp <= degree; ++icp) {
-            gp_Pnt pnt(cp_x.Value(icp), cp_y.Value(icp), cp_z.Value(icp));
-            poles.SetValue(nParams + icp, pnt);
+    std::vector<Handle(Geom_BSplineCurve)> curves(pointSets.size());
+    std::vector<std::exception_ptr> errors(pointSets.size());
+    auto solveSet = [&](int iset) {
+        const InterpolationSystem& system = closed[iset] ? *closedSystem : *openSystem;
+        try {
+            curves[iset] = system.Solve(pointSets[iset]->Array1());
         }
-    }
-    if (needsShifting()) {
-        // add a new control point and knot
-        size_t deg = static_cast<size_t>(degree);
-        knots.push_back(knots.back() + knots[2 * deg + 1] - knots[2 * deg]);
-        poles.SetValue(nParams + degree + 1, poles.Value(degree + 1));
-
-        // shift back the knots
-        for (size_t iknot = 0; iknot < knots.size(); ++iknot) {
-            knots[iknot] -= params[0];
+        catch (...) {
+            // exceptions must not leave the parallel loop. They are rethrown after the loop.
+            errors[iset] = std::current_exception();
         }
-    }
-
-    Handle(TColStd_HArray1OfReal) occFlatKnots = toArray(knots);
-    int knotsLen                               = BSplCLib::KnotsLength(occFlatKnots->Array1());
+    };
+    OSD_Parallel::For(0, static_cast<int>(pointSets.size()), solveSet, !parallel);
 
-    TColStd_Array1OfReal occKnots(1, knotsLen);
-    TColStd_Array1OfInteger occMults(1, knotsLen);
-    BSplCLib::Knots(occFlatKnots->Array1(), occKnots, occMults);
-
-    Handle(Geom_BSplineCurve) result = new Geom_BSplineCurve(poles, occKnots, occMults, degree, false);
+    for (const auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
 
-    // clamp bspline
-    if (isClosed()) {
-        clamp(result, m_params.front(), m_params.back());
+    for (size_t iset = 0; iset < curves.size(); ++iset) {
+        if (curves[iset].IsNull()) {
+            throw Error("Cannot interpolate point set " + std::to_string(iset) + " in PointsToBSplineInterpolation::Curves", geoml::MATH_ERROR);
+        }
     }
 
-    return result;
+    return curves;
 }
 
 double PointsToBSplineInterpolation::maxDistanceOfBoundingBox(const TColgp_Array1OfPnt& points) const
@@ -235,11 +318,6 @@ bool PointsToBSplineInterpolation::isClosed() const
     return m_pnts->Value(m_pnts->Lower()).IsEqual(m_pnts->Value(m_pnts->Upper()), error) && m_C2Continuous;
 }
 
-bool PointsToBSplineInterpolation::needsShifting() const
-{
-    return (Degree() % 2) == 0 && isClosed();
-}
-
 PointsToBSplineInterpolation::operator Handle(Geom_BSplineCurve)() const
 {
     return Curve();
@@ -46,6 +46,24 @@ public:
     /// Returns the interpolation curve
     GEOML_EXPORT Handle(Geom_BSplineCurve) Curve() const;
 
+    /**
+     * @brief Interpolates several point sets that share the same parameters
+     *
+     * The interpolation matrix is factorized only once (per open and closed
+     * point sets) and then solved for each point set.
+     *
+     * @param pointSets          The point sets to interpolate. All must have as many points as parameters.
+     * @param parameters         The common curve parameters of the points
+     * @param maxDegree          Maximum degree of the resulting curves
+     * @param continuousIfClosed Creates continuous curves for closed point sets
+     * @param parallel           Solves the point sets in parallel
+     * @return The interpolation curves in the order of the point sets
+     */
+    GEOML_EXPORT static std::vector<Handle(Geom_BSplineCurve)> Curves(const std::vector<Handle(TColgp_HArray1OfPnt)>& pointSets,
+                                                                      const std::vector<double>& parameters,
+                                                                      unsigned int maxDegree = 3, bool continuousIfClosed = false,
+                                                                      bool parallel = true);
+
     GEOML_EXPORT operator Handle(Geom_BSplineCurve)() const;
 
     /// Returns the parameters of the interpolated points
@@ -61,8 +79,6 @@ private:
 
     bool isClosed() const;
 
-    bool needsShifting() const;
-
     /// curve coordinates to be fitted by the B-spline
     const Handle(TColgp_HArray1OfPnt) m_pnts;
 
@@ -0,0 +1,531 @@
+/*
+* Copyright (C) 2026 German Aerospace Center (DLR/SC)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "SurfaceCache.h"
+
+#include "geoml_config.h"
+#include "geoml/error.h"
+#include "logging/Logging.h"
+
+#include <Geom_BSplineCurve.hxx>
+#include <GeomConvert.hxx>
+#include <Standard_Failure.hxx>
+#include <TColgp_Array2OfPnt.hxx>
+#include <TColStd_Array1OfInteger.hxx>
+#include <TColStd_Array1OfReal.hxx>
+#include <TColStd_Array2OfReal.hxx>
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <thread>
+
+namespace
+{
+
+// magic number and version of the binary surface format
+const char BINARY_MAGIC[8] = {'G', 'E', 'O', 'M', 'L', 'S', 'R', 'F'};
+const uint32_t BINARY_VERSION = 1;
+
+uint64_t rotl(uint64_t x, int r)
+{
+    return (x << r) | (x >> (64 - r));
+}
+
+uint64_t fmix(uint64_t k)
+{
+    k ^= k >> 33;
+    k *= 0xff51afd7ed558ccdULL;
+    k ^= k >> 33;
+    k *= 0xc4ceb9fe1a85ec53ULL;
+    k ^= k >> 33;
+    return k;
+}
+
+template <typename T>
+void writeValue(std::ostream& stream, T value)
+{
+    stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool readValue(std::istream& stream, T& value)
+{
+    stream.read(reinterpret_cast<char*>(&value), sizeof(T));
+    return static_cast<bool>(stream);
+}
+
+// Returns a random number for unique temporary file names
+uint64_t randomSuffix()
+{
+    static std::mutex mutex;
+    static std::mt19937_64 generator(std::random_device{}());
+    std::lock_guard<std::mutex> guard(mutex);
+    return generator();
+}
+
+// Returns the number of bytes left in the stream or -1, if the stream is not seekable
+std::streamoff remainingBytes(std::istream& stream)
+{
+    const std::streampos current = stream.tellg();
+    if (current == std::streampos(-1)) {
+        stream.clear();
+        return -1;
+    }
+    stream.seekg(0, std::ios::end);
+    const std::streampos end = stream.tellg();
+    stream.seekg(current);
+    if (end == std::streampos(-1) || !stream) {
+        stream.clear();
+        stream.seekg(current);
+        return -1;
+    }
+    return end - current;
+}
+
+// Checks, that the stream can contain the given numbers of knots and poles,
+// such that corrupt files do not lead to huge allocations
+bool sizesFitIntoStream(std::istream& stream, int32_t nUKnots, int32_t nVKnots, int32_t nUPoles, int32_t nVPoles, bool rational)
+{
+    // upper bounds for non-seekable streams
+    const uint64_t maxKnots = uint64_t(1) << 20;
+    const uint64_t maxPoles = uint64_t(1) << 24;
+
+    const uint64_t knotSize = sizeof(double) + sizeof(int32_t);
+    const uint64_t poleSize = (rational ? 4 : 3) * sizeof(double);
+    const uint64_t nKnots = static_cast<uint64_t>(nUKnots) + static_cast<uint64_t>(nVKnots);
+    const uint64_t nPoles = static_cast<uint64_t>(nUPoles) * static_cast<uint64_t>(nVPoles);
+
+    const std::streamoff remaining = remainingBytes(stream);
+    if (remaining < 0) {
+        return nKnots <= maxKnots && nPoles <= maxPoles;
+    }
+
+    // divide instead of multiplying to avoid overflows
+    const uint64_t available = static_cast<uint64_t>(remaining);
+    if (nKnots > available / knotSize) {
+        return false;
+    }
+    return nPoles <= (available - nKnots * knotSize) / poleSize;
+}
+
+} // namespace
+
+namespace geoml
+{
+
+SurfaceCacheKey::SurfaceCacheKey(const std::string& algorithm)
+    : m_h1(0x9e3779b97f4a7c15ULL)
+    , m_h2(0x632be59bd9b4e019ULL)
+{
+    // the cached algorithms might change their results with each version of geoml
+    Add(GEOML_VERSION);
+    Add(GEOML_REVISION);
+    Add(algorithm);
+}
+
+void SurfaceCacheKey::addWord(uint64_t word)
+{
+    // two lanes of a murmur3 like mixing function
+    const uint64_t c1 = 0x87c37b91114253d5ULL;
+    const uint64_t c2 = 0x4cf5ad432745937fULL;
+
+    uint64_t k1 = word * c1;
+    k1 = rotl(k1, 31) * c2;
+    m_h1 ^= k1;
+    m_h1 = rotl(m_h1, 27) + m_h2;
+    m_h1 = m_h1 * 5 + 0x52dce729;
+
+    uint64_t k2 = word * c2;
+    k2 = rotl(k2, 33) * c1;
+    m_h2 ^= k2;
+    m_h2 = rotl(m_h2, 31) + m_h1;
+    m_h2 = m_h2 * 5 + 0x38495ab5;
+}
+
+SurfaceCacheKey& SurfaceCacheKey::Add(double value)
+{
+    // -0.0 and 0.0 must result in the same key
+    if (value == 0.) {
+        value = 0.;
+    }
+    uint64_t word = 0;
+    std::memcpy(&word, &value, sizeof(double));
+    addWord(word);
+    return *this;
+}
+
+SurfaceCacheKey& SurfaceCacheKey::Add(int value)
+{
+    addWord(static_cast<uint64_t>(static_cast<int64_t>(value)));
+    return *this;
+}
+
+SurfaceCacheKey& SurfaceCacheKey::Add(unsigned int value)
+{
+    addWord(static_cast<uint64_t>(value));
+    return *this;
+}
+
+SurfaceCacheKey& SurfaceCacheKey::Add(bool value)
+{
+    addWord(value ? 1 : 0);
+    return *this;
+}
+
+SurfaceCacheKey& SurfaceCacheKey::Add(const std::string& value)
+{
+    addWord(value.size());
+    for (size_t i = 0; i < value.size(); i += 8) {
+        uint64_t word = 0;
+        std::memcpy(&word, value.data() + i, std::min<size_t>(8, value.size() - i));
+        addWord(word);
+    }
+    return *this;
+}
+
+SurfaceCacheKey& SurfaceCacheKey::Add(const Handle(Geom_Curve)& curve)
+{
+    if (curve.IsNull()) {
+        throw Error("Null pointer curve in SurfaceCacheKey::Add", geoml::NULL_POINTER);
+    }
+
+    Handle(Geom_BSplineCurve) bspline = GeomConvert::CurveToBSplineCurve(curve);
+
+    Add(bspline->Degree());
+    Add(static_cast<bool>(bspline->IsPeriodic()));
+    Add(bspline->NbKnots());
+    for (int i = 1; i <= bspline->NbKnots(); ++i) {
+        Add(bspline->Knot(i));
+        Add(bspline->Multiplicity(i));
+    }
+    Add(bspline->NbPoles());
+    for (int i = 1; i <= bspline->NbPoles(); ++i) {
+        const gp_Pnt& pole = bspline->Pole(i);
+        Add(pole.X());
+        Add(pole.Y());
+        Add(pole.Z());
+        Add(bspline->Weight(i));
+    }
+    return *this;
+}
+
+SurfaceCacheKey& SurfaceCacheKey::Add(const std::vector<Handle(Geom_Curve)>& curves)
+{
+    addWord(curves.size());
+    for (const auto& curve : curves) {
+        Add(curve);
+    }
+    return *this;
+}
+
+std::string SurfaceCacheKey::Str() const
+{
+    std::stringstream str;
+    str << std::hex << std::setfill('0') << std::setw(16) << fmix(m_h1 ^ m_h2)
+        << std::setw(16) << fmix(m_h2 + m_h1);
+    return str.str();
+}
+
+SurfaceCache& SurfaceCache::Instance()
+{
+    static SurfaceCache cache;
+    return cache;
+}
+
+SurfaceCache::SurfaceCache()
+    : m_enabled(false)
+    , m_maxEntries(0)
+{
+}
+
+void SurfaceCache::Enable(size_t maxEntries, const std::string& directory)
+{
+    if (!directory.empty()) {
+        std::error_code error;
+        std::filesystem::create_directories(directory, error);
+        if (error) {
+            throw Error("Cannot create surface cache directory " + directory + ": " + error.message());
+        }
+    }
+
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_enabled = true;
+    m_maxEntries = maxEntries;
+    m_directory = directory;
+
+    while (m_entries.size() > m_maxEntries) {
+        m_index.erase(m_entries.back().first);
+        m_entries.pop_back();
+    }
+}
+
+void SurfaceCache::Disable()
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_enabled = false;
+    m_entries.clear();
+    m_index.clear();
+}
+
+bool SurfaceCache::IsEnabled() const
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return m_enabled;
+}
+
+void SurfaceCache::Clear()
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_entries.clear();
+    m_index.clear();
+}
+
+size_t SurfaceCache::Size() const
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return m_entries.size();
+}
+
+Handle(Geom_BSplineSurface) SurfaceCache::GetOrCompute(const SurfaceCacheKey& key,
+                                                       const std::function<Handle(Geom_BSplineSurface)()>& compute)
+{
+    if (!IsEnabled()) {
+        return compute();
+    }
+
+    const std::string keyStr = key.Str();
+    Handle(Geom_BSplineSurface) surface = get(keyStr);
+    if (!surface.IsNull()) {
+        return surface;
+    }
+
+    // The computation is done without holding the lock. Concurrent requests
+    // of the same key might compute the surface twice, which is harmless.
+    surface = compute();
+    if (!surface.IsNull()) {
+        put(keyStr, surface);
+    }
+    return surface;
+}
+
+Handle(Geom_BSplineSurface) SurfaceCache::get(const std::string& key)
+{
+    std::string file;
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        auto it = m_index.find(key);
+        if (it != m_index.end()) {
+            // move to front of the lru list
+            m_entries.splice(m_entries.begin(), m_entries, it->second);
+            return Handle(Geom_BSplineSurface)::DownCast(it->second->second->Copy());
+        }
+        if (m_directory.empty()) {
+            return nullptr;
+        }
+        file = filename(key);
+    }
+
+    std::ifstream stream(file, std::ios::binary);
+    if (!stream) {
+        return nullptr;
+    }
+
+    Handle(Geom_BSplineSurface) surface = ReadBinarySurface(stream);
+    if (surface.IsNull()) {
+        LOG(WARNING) << "Ignoring invalid surface cache file " << file;
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> guard(m_mutex);
+    insertMemory(key, Handle(Geom_BSplineSurface)::DownCast(surface->Copy()));
+    return surface;
+}
+
+void SurfaceCache::put(const std::string& key, const Handle(Geom_BSplineSurface)& surface)
+{
+    std::string file;
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        insertMemory(key, Handle(Geom_BSplineSurface)::DownCast(surface->Copy()));
+        if (m_directory.empty()) {
+            return;
+        }
+        file = filename(key);
+    }
+
+    // Write into a temporary file first and rename it afterwards. Hence, other
+    // processes never read partially written files.
+    // The random suffix distinguishes threads with equal ids in different processes
+    std::stringstream tmpName;
+    tmpName << file << "." << std::this_thread::get_id() << "." << std::hex << randomSuffix() << ".tmp";
+    {
+        std::ofstream stream(tmpName.str(), std::ios::binary | std::ios::trunc);
+        WriteBinarySurface(surface, stream);
+        if (!stream) {
+            LOG(WARNING) << "Cannot write surface cache file " << tmpName.str();
+            return;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(tmpName.str(), file, error);
+    if (error) {
+        LOG(WARNING) << "Cannot write surface cache file " << file << ": " << error.message();
+        std::filesystem::remove(tmpName.str(), error);
+    }
+}
+
+void SurfaceCache::insertMemory(const std::string& key, const Handle(Geom_BSplineSurface)& surface)
+{
+    if (!m_enabled || m_maxEntries == 0) {
+        return;
+    }
+
+    auto it = m_index.find(key);
+    if (it != m_index.end()) {
+        it->second->second = surface;
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+        return;
+    }
+
+    m_entries.emplace_front(key, surface);
+    m_index[key] = m_entries.begin();
+
+    if (m_entries.size() > m_maxEntries) {
+        m_index.erase(m_entries.back().first);
+        m_entries.pop_back();
+    }
+}
+
+std::string SurfaceCache::filename(const std::string& key) const
+{
+    return (std::filesystem::path(m_directory) / (key + ".bsurf")).string();
+}
+
+void WriteBinarySurface(const Handle(Geom_BSplineSurface)& surface, std::ostream& stream)
+{
+    if (surface.IsNull()) {
+        throw Error("Null pointer surface in WriteBinarySurface", geoml::NULL_POINTER);
+    }
+
+    stream.write(BINARY_MAGIC, sizeof(BINARY_MAGIC));
+    writeValue<uint32_t>(stream, BINARY_VERSION);
+
+    const bool rational = surface->IsURational() || surface->IsVRational();
+    writeValue<int32_t>(stream, surface->UDegree());
+    writeValue<int32_t>(stream, surface->VDegree());
+    writeValue<uint8_t>(stream, surface->IsUPeriodic() ? 1 : 0);
+    writeValue<uint8_t>(stream, surface->IsVPeriodic() ? 1 : 0);
+    writeValue<uint8_t>(stream, rational ? 1 : 0);
+    writeValue<int32_t>(stream, surface->NbUKnots());
+    writeValue<int32_t>(stream, surface->NbVKnots());
+    writeValue<int32_t>(stream, surface->NbUPoles());
+    writeValue<int32_t>(stream, surface->NbVPoles());
+
+    for (int i = 1; i <= surface->NbUKnots(); ++i) {
+        writeValue<double>(stream, surface->UKnot(i));
+        writeValue<int32_t>(stream, surface->UMultiplicity(i));
+    }
+    for (int i = 1; i <= surface->NbVKnots(); ++i) {
+        writeValue<double>(stream, surface->VKnot(i));
+        writeValue<int32_t>(stream, surface->VMultiplicity(i));
+    }
+
+    for (int i = 1; i <= surface->NbUPoles(); ++i) {
+        for (int j = 1; j <= surface->NbVPoles(); ++j) {
+            const gp_Pnt& pole = surface->Pole(i, j);
+            writeValue<double>(stream, pole.X());
+            writeValue<double>(stream, pole.Y());
+            writeValue<double>(stream, pole.Z());
+            if (rational) {
+                writeValue<double>(stream, surface->Weight(i, j));
+            }
+        }
+    }
+}
+
+Handle(Geom_BSplineSurface) ReadBinarySurface(std::istream& stream)
+{
+    char magic[sizeof(BINARY_MAGIC)];
+    uint32_t version = 0;
+    stream.read(magic, sizeof(magic));
+    if (!stream || std::memcmp(magic, BINARY_MAGIC, sizeof(magic)) != 0 || !readValue(stream, version) || version != BINARY_VERSION) {
+        return nullptr;
+    }
+
+    int32_t udegree = 0, vdegree = 0, nUKnots = 0, nVKnots = 0, nUPoles = 0, nVPoles = 0;
+    uint8_t uperiodic = 0, vperiodic = 0, rational = 0;
+    if (!readValue(stream, udegree) || !readValue(stream, vdegree) ||
+        !readValue(stream, uperiodic) || !readValue(stream, vperiodic) || !readValue(stream, rational) ||
+        !readValue(stream, nUKnots) || !readValue(stream, nVKnots) ||
+        !readValue(stream, nUPoles) || !readValue(stream, nVPoles)) {
+        return nullptr;
+    }
+
+    if (nUKnots < 2 || nVKnots < 2 || nUPoles < 2 || nVPoles < 2) {
+        return nullptr;
+    }
+
+    if (!sizesFitIntoStream(stream, nUKnots, nVKnots, nUPoles, nVPoles, rational != 0)) {
+        return nullptr;
+    }
+
+    TColStd_Array1OfReal uknots(1, nUKnots), vknots(1, nVKnots);
+    TColStd_Array1OfInteger umults(1, nUKnots), vmults(1, nVKnots);
+    for (int i = 1; i <= nUKnots; ++i) {
+        if (!readValue(stream, uknots(i)) || !readValue(stream, umults(i))) {
+            return nullptr;
+        }
+    }
+    for (int i = 1; i <= nVKnots; ++i) {
+        if (!readValue(stream, vknots(i)) || !readValue(stream, vmults(i))) {
+            return nullptr;
+        }
+    }
+
+    TColgp_Array2OfPnt poles(1, nUPoles, 1, nVPoles);
+    TColStd_Array2OfReal weights(1, nUPoles, 1, nVPoles);
+    weights.Init(1.);
+    for (int i = 1; i <= nUPoles; ++i) {
+        for (int j = 1; j <= nVPoles; ++j) {
+            double x = 0., y = 0., z = 0.;
+            if (!readValue(stream, x) || !readValue(stream, y) || !readValue(stream, z)) {
+                return nullptr;
+            }
+            poles(i, j).SetCoord(x, y, z);
+            if (rational && !readValue(stream, weights(i, j))) {
+                return nullptr;
+            }
+        }
+    }
+
+    try {
+        return new Geom_BSplineSurface(poles, weights, uknots, vknots, umults, vmults,
+                                       udegree, vdegree, uperiodic != 0, vperiodic != 0);
+    }
+    catch (const Standard_Failure&) {
+        // inconsistent data
+        return nullptr;
+    }
+}
+
+} // namespace geoml
@@ -0,0 +1,144 @@
+/*
+* Copyright (C) 2026 German Aerospace Center (DLR/SC)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#pragma once
+
+#include "geoml_internal.h"
+
+#include <Geom_BSplineSurface.hxx>
+#include <Geom_Curve.hxx>
+
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace geoml
+{
+
+/**
+ * @brief Computes a key from the content of the inputs of a geometric algorithm
+ *
+ * The key is a 128 bit hash of all values added. Curves are hashed by the
+ * degree, knots, multiplicities, poles and weights of their B-spline
+ * representation. Hence, equal inputs result in the same key, even if they
+ * are different objects or were created in different processes.
+ */
+class SurfaceCacheKey
+{
+public:
+    /// The version and git revision of geoml are part of the key, hence
+    /// results of previous versions are never reused.
+    /// @param algorithm Name of the algorithm, which is part of the key
+    GEOML_EXPORT explicit SurfaceCacheKey(const std::string& algorithm);
+
+    GEOML_EXPORT SurfaceCacheKey& Add(double value);
+    GEOML_EXPORT SurfaceCacheKey& Add(int value);
+    GEOML_EXPORT SurfaceCacheKey& Add(unsigned int value);
+    GEOML_EXPORT SurfaceCacheKey& Add(bool value);
+    GEOML_EXPORT SurfaceCacheKey& Add(const std::string& value);
+    SurfaceCacheKey& Add(const char* value)
+    {
+        return Add(std::string(value));
+    }
+    GEOML_EXPORT SurfaceCacheKey& Add(const Handle(Geom_Curve)& curve);
+    GEOML_EXPORT SurfaceCacheKey& Add(const std::vector<Handle(Geom_Curve)>& curves);
+
+    /// Returns the key as a hexadecimal string
+    GEOML_EXPORT std::string Str() const;
+
+private:
+    void addWord(uint64_t word);
+
+    uint64_t m_h1;
+    uint64_t m_h2;
+};
+
+/**
+ * @brief Process wide cache of B-spline surfaces computed by geometric algorithms
+ *
+ * The cache is disabled by default. If enabled, it keeps the most recently used
+ * surfaces in memory. Optionally, all surfaces are also written into a directory
+ * in a compact binary format, such that they can be shared between processes
+ * and restarts.
+ *
+ * The surfaces are copied when stored and retrieved. Hence, callers may
+ * modify the returned surfaces without affecting the cache.
+ *
+ * All methods are thread safe.
+ */
+class SurfaceCache
+{
+public:
+    GEOML_EXPORT static SurfaceCache& Instance();
+
+    /**
+     * @brief Enables the cache
+     *
+     * @param maxEntries Maximum number of surfaces kept in memory
+     * @param directory  If not empty, the surfaces are stored in this directory as well
+     */
+    GEOML_EXPORT void Enable(size_t maxEntries, const std::string& directory = "");
+
+    /// Disables the cache and releases the surfaces in memory
+    GEOML_EXPORT void Disable();
+
+    GEOML_EXPORT bool IsEnabled() const;
+
+    /// Removes all surfaces from memory. Files on disk are kept.
+    GEOML_EXPORT void Clear();
+
+    /// Returns the number of surfaces in memory
+    GEOML_EXPORT size_t Size() const;
+
+    /**
+     * @brief Returns the cached surface of the key or computes and stores it
+     *
+     * If the cache is disabled, the surface is just computed.
+     */
+    GEOML_EXPORT Handle(Geom_BSplineSurface) GetOrCompute(const SurfaceCacheKey& key,
+                                                         const std::function<Handle(Geom_BSplineSurface)()>& compute);
+
+private:
+    SurfaceCache();
+
+    Handle(Geom_BSplineSurface) get(const std::string& key);
+    void put(const std::string& key, const Handle(Geom_BSplineSurface)& surface);
+    void insertMemory(const std::string& key, const Handle(Geom_BSplineSurface)& surface);
+    std::string filename(const std::string& key) const;
+
+    typedef std::list<std::pair<std::string, Handle(Geom_BSplineSurface)>> EntryList;
+
+    mutable std::mutex m_mutex;
+    bool m_enabled;
+    size_t m_maxEntries;
+    std::string m_directory;
+    // most recently used entries first
+    EntryList m_entries;
+    std::unordered_map<std::string, EntryList::iterator> m_index;
+};
+
+/// Writes the surface in the binary format of the SurfaceCache
+GEOML_EXPORT void WriteBinarySurface(const Handle(Geom_BSplineSurface)& surface, std::ostream& stream);
+
+/// Reads a surface in the binary format of the SurfaceCache. Returns a null handle if the data is invalid.
+GEOML_EXPORT Handle(Geom_BSplineSurface) ReadBinarySurface(std::istream& stream);
+
+} // namespace geoml
@@ -22,11 +22,17 @@
 #include "geoml/error.h"
 #include "BSplineAlgorithms.h"
 #include "CurvesToSurface.h"
+#include "BSplineEvaluator.h"
 #include "common/CommonFunctions.h"
 #include <TColgp_Array2OfPnt.hxx>
+#include <TColStd_Array1OfInteger.hxx>
+#include <TColStd_Array1OfReal.hxx>
+#include <TColStd_Array2OfReal.hxx>
+#include <OSD_Parallel.hxx>
 
 #include <algorithm>
 #include <cassert>
+#include <exception>
 
 namespace
 {
@@ -136,11 +142,11 @@ void GordonSurfaceBuilder::CreateGordonSurface(const std::vector<Handle(Geom_BSp
 
     // use splines in u-direction to get intersection points
     for (size_t spline_idx = 0; spline_idx < profiles.size(); ++spline_idx) {
+        BSplineCurveEvaluator spline_u(profiles[spline_idx]);
         for (size_t intersection_idx = 0; intersection_idx < intersection_params_spline_u.size(); ++intersection_idx) {
-            Handle(Geom_BSplineCurve) spline_u = profiles[spline_idx];
             double parameter = intersection_params_spline_u[intersection_idx];
             intersection_pnts(static_cast<Standard_Integer>(intersection_idx + 1),
-                              static_cast<Standard_Integer>(spline_idx + 1)) = spline_u->Value(parameter);
+                              static_cast<Standard_Integer>(spline_idx + 1)) = spline_u.Value(parameter);
         }
     }
 
@@ -152,24 +158,47 @@ void GordonSurfaceBuilder::CreateGordonSurface(const std::vector<Handle(Geom_BSp
     bool makeUClosed = BSplineAlgorithms::isUDirClosed(intersection_pnts, tp_tolerance) && guides.front()->IsEqual(guides.back(), curve_u_tolerance);
     bool makeVClosed = BSplineAlgorithms::isVDirClosed(intersection_pnts, tp_tolerance) && profiles.front()->IsEqual(profiles.back(), curve_v_tolerance);
 
-    // Skinning in v-direction with u directional B-Splines
-    CurvesToSurface surfProfilesSkinner(std::vector<Handle(Geom_Curve)>(profiles.begin(), profiles.end()), intersection_params_spline_v, makeVClosed);
-    Handle(Geom_BSplineSurface) surfProfiles = surfProfilesSkinner.Surface();
-    // therefore reparametrization before this method
+    // The skinning surfaces of the profiles and guides and the tensor product surface
+    // are independent of each other and are computed concurrently
+    Handle(Geom_BSplineSurface) surfProfiles, surfGuides, tensorProdSurf;
+    std::exception_ptr errors[3];
+    OSD_Parallel::For(0, 3, [&](int task) {
+        try {
+            if (task == 0) {
+                // Skinning in v-direction with u directional B-Splines
+                CurvesToSurface surfProfilesSkinner(std::vector<Handle(Geom_Curve)>(profiles.begin(), profiles.end()), intersection_params_spline_v, makeVClosed);
+                surfProfiles = surfProfilesSkinner.Surface();
+                // therefore reparametrization before this method
+            }
+            else if (task == 1) {
+                // Skinning in u-direction with v directional B-Splines
+                CurvesToSurface surfGuidesSkinner(std::vector<Handle(Geom_Curve)>(guides.begin(), guides.end()), intersection_params_spline_u, makeUClosed);
+                surfGuides = surfGuidesSkinner.Surface();
 
-    // Skinning in u-direction with v directional B-Splines
-    CurvesToSurface surfGuidesSkinner(std::vector<Handle(Geom_Curve)>(guides.begin(), guides.end()), intersection_params_spline_u, makeUClosed);
-    Handle(Geom_BSplineSurface) surfGuides = surfGuidesSkinner.Surface();
+                // flipping of the surface in v-direction; flipping is redundant here, therefore the next line is a comment!
+                surfGuides = BSplineAlgorithms::flipSurface(surfGuides);
+            }
+            else {
+                // if there are too little points for degree in u-direction = 3 and degree in v-direction=3 creating an interpolation B-spline surface isn't possible in Open CASCADE
 
-    // flipping of the surface in v-direction; flipping is redundant here, therefore the next line is a comment!
-    surfGuides = BSplineAlgorithms::flipSurface(surfGuides);
+                // Open CASCADE doesn't have a B-spline surface interpolation method where one can give the u- and v-directional parameters as arguments
+                tensorProdSurf = BSplineAlgorithms::pointsToSurface(intersection_pnts,
+                                                                    intersection_params_spline_u, intersection_params_spline_v,
+                                                                    makeUClosed, makeVClosed);
+            }
+        }
+        catch (...) {
+            // exceptions must not leave the parallel loop
+            errors[task] = std::current_exception();
+        }
+    });
 
-    // if there are too little points for degree in u-direction = 3 and degree in v-direction=3 creating an interpolation B-spline surface isn't possible in Open CASCADE
+    for (const std::exception_ptr& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
 
-    // Open CASCADE doesn't have a B-spline surface interpolation method where one can give the u- and v-directional parameters as arguments
-    Handle(Geom_BSplineSurface) tensorProdSurf = BSplineAlgorithms::pointsToSurface(intersection_pnts,
-                                                                                         intersection_params_spline_u, intersection_params_spline_v,
-                                                                                         makeUClosed, makeVClosed);
     // match degree of all three surfaces
     Standard_Integer degreeU = std::max(std::max(surfGuides->UDegree(),
                                                  surfProfiles->UDegree()),
@@ -202,18 +231,35 @@ void GordonSurfaceBuilder::CreateGordonSurface(const std::vector<Handle(Geom_BSp
     assert(m_skinningSurfGuides->NbUPoles() == m_skinningSurfProfiles->NbUPoles() && m_skinningSurfProfiles->NbUPoles() == m_tensorProdSurf->NbUPoles());
     assert(m_skinningSurfGuides->NbVPoles() == m_skinningSurfProfiles->NbVPoles() && m_skinningSurfProfiles->NbVPoles() == m_tensorProdSurf->NbVPoles());
 
-    m_gordonSurf = Handle(Geom_BSplineSurface)::DownCast(m_skinningSurfProfiles->Copy());
+    // creating the Gordon Surface = s_u + s_v - tps by adding the control points.
+    // Each row of control points is computed independently.
+    TColgp_Array2OfPnt gordonPoles(1, m_skinningSurfProfiles->NbUPoles(), 1, m_skinningSurfProfiles->NbVPoles());
+    OSD_Parallel::For(1, m_skinningSurfProfiles->NbUPoles() + 1, [&](int cp_u_idx) {
+        for (int cp_v_idx = 1; cp_v_idx <= gordonPoles.UpperCol(); ++cp_v_idx) {
+            const gp_Pnt& cp_surf_u = m_skinningSurfProfiles->Pole(cp_u_idx, cp_v_idx);
+            const gp_Pnt& cp_surf_v = m_skinningSurfGuides->Pole(cp_u_idx, cp_v_idx);
+            const gp_Pnt& cp_tensor = m_tensorProdSurf->Pole(cp_u_idx, cp_v_idx);
 
-    // creating the Gordon Surface = s_u + s_v - tps by adding the control points
-    for (int cp_u_idx = 1; cp_u_idx <= m_gordonSurf->NbUPoles(); ++cp_u_idx) {
-        for (int cp_v_idx = 1; cp_v_idx <= m_gordonSurf->NbVPoles(); ++cp_v_idx) {
-            gp_Pnt cp_surf_u = m_skinningSurfProfiles->Pole(cp_u_idx, cp_v_idx);
-            gp_Pnt cp_surf_v = m_skinningSurfGuides->Pole(cp_u_idx, cp_v_idx);
-            gp_Pnt cp_tensor = m_tensorProdSurf->Pole(cp_u_idx, cp_v_idx);
-
-            m_gordonSurf->SetPole(cp_u_idx, cp_v_idx, cp_surf_u.XYZ() + cp_surf_v.XYZ() - cp_tensor.XYZ());
+            gordonPoles(cp_u_idx, cp_v_idx) = cp_surf_u.XYZ() + cp_surf_v.XYZ() - cp_tensor.XYZ();
         }
-    }
+    });
+
+    // the Gordon surface shares the knots and weights of the profile surface
+    TColStd_Array1OfReal uknots(1, m_skinningSurfProfiles->NbUKnots());
+    TColStd_Array1OfReal vknots(1, m_skinningSurfProfiles->NbVKnots());
+    TColStd_Array1OfInteger umults(1, m_skinningSurfProfiles->NbUKnots());
+    TColStd_Array1OfInteger vmults(1, m_skinningSurfProfiles->NbVKnots());
+    m_skinningSurfProfiles->UKnots(uknots);
+    m_skinningSurfProfiles->VKnots(vknots);
+    m_skinningSurfProfiles->UMultiplicities(umults);
+    m_skinningSurfProfiles->VMultiplicities(vmults);
+
+    TColStd_Array2OfReal weights(1, gordonPoles.ColLength(), 1, gordonPoles.RowLength());
+    m_skinningSurfProfiles->Weights(weights);
+
+    m_gordonSurf = new Geom_BSplineSurface(gordonPoles, weights, uknots, vknots, umults, vmults,
+                                           m_skinningSurfProfiles->UDegree(), m_skinningSurfProfiles->VDegree(),
+                                           m_skinningSurfProfiles->IsUPeriodic(), m_skinningSurfProfiles->IsVPeriodic());
 }
 
 void GordonSurfaceBuilder::CheckCurveNetworkCompatibility(const std::vector<Handle(Geom_BSplineCurve) >& profiles,
@@ -234,15 +280,16 @@ void GordonSurfaceBuilder::CheckCurveNetworkCompatibility(const std::vector<Hand
     }
 
     // check compatibilty of network
+    std::vector<BSplineCurveEvaluator> profileEvaluators(profiles.begin(), profiles.end());
     for (size_t u_param_idx = 0; u_param_idx < intersection_params_spline_u.size(); ++u_param_idx) {
         double spline_u_param = intersection_params_spline_u[u_param_idx];
-        const Handle(Geom_BSplineCurve)& spline_v = guides[u_param_idx];
+        BSplineCurveEvaluator spline_v(guides[u_param_idx]);
         for (size_t v_param_idx = 0; v_param_idx < intersection_params_spline_v.size(); ++v_param_idx) {
-            const Handle(Geom_BSplineCurve)& spline_u = profiles[v_param_idx];
+            const BSplineCurveEvaluator& spline_u = profileEvaluators[v_param_idx];
             double spline_v_param = intersection_params_spline_v[v_param_idx];
 
-            gp_Pnt p_prof = spline_u->Value(spline_u_param);
-            gp_Pnt p_guid = spline_v->Value(spline_v_param);
+            gp_Pnt p_prof = spline_u.Value(spline_u_param);
+            gp_Pnt p_guid = spline_v.Value(spline_v_param);
             double distance = p_prof.Distance(p_guid);
 
             if (distance > splines_scale * tol) {
@@ -27,11 +27,28 @@
 #include "Debugging.h"
 
 #include <algorithm>
+#include <exception>
+#include <iterator>
 
 #include <math_Matrix.hxx>
+#include <Bnd_Box.hxx>
+#include <OSD_Parallel.hxx>
 #include <TColStd_HArray1OfReal.hxx>
 #include <GeomConvert.hxx>
 
+namespace
+{
+
+// Copies the curve into a B-spline with the parameter range [0, 1]
+Handle(Geom_BSplineCurve) prepareCurve(const Handle(Geom_Curve)& curve)
+{
+    Handle(Geom_BSplineCurve) bspline = GeomConvert::CurveToBSplineCurve(curve);
+    geoml::BSplineAlgorithms::reparametrizeBSpline(*bspline, 0., 1., 1e-15);
+    return bspline;
+}
+
+} // namespace
+
 namespace geoml
 {
 
@@ -50,16 +67,48 @@ InterpolateCurveNetwork::InterpolateCurveNetwork(const std::vector<Handle (Geom_
         throw Error("There must be at least two guides for the curve network interpolation.", geoml::MATH_ERROR);
     }
     
-    m_profiles.reserve(profiles.size());
-    m_guides.reserve(guides.size());
+    m_inputProfiles.reserve(profiles.size());
+    m_inputGuides.reserve(guides.size());
 
     // Copy the curves
     for (std::vector<Handle (Geom_Curve)>::const_iterator it = profiles.begin(); it != profiles.end(); ++it) {
-        m_profiles.push_back(GeomConvert::CurveToBSplineCurve(*it));
+        m_inputProfiles.push_back(prepareCurve(*it));
     }
     for (std::vector<Handle (Geom_Curve)>::const_iterator it = guides.begin(); it != guides.end(); ++it) {
-        m_guides.push_back(GeomConvert::CurveToBSplineCurve(*it));
+        m_inputGuides.push_back(prepareCurve(*it));
+    }
+
+    // all intersections have to be computed
+    m_profileChanged.assign(profiles.size(), 1);
+    m_guideChanged.assign(guides.size(), 1);
+}
+
+void InterpolateCurveNetwork::ReplaceProfile(size_t index, const Handle(Geom_Curve)& profile)
+{
+    if (index >= m_inputProfiles.size()) {
+        throw Error("Invalid profile index in InterpolateCurveNetwork::ReplaceProfile", geoml::INDEX_ERROR);
+    }
+    if (profile.IsNull()) {
+        throw Error("Null pointer profile in InterpolateCurveNetwork::ReplaceProfile", geoml::NULL_POINTER);
     }
+
+    m_inputProfiles[index] = prepareCurve(profile);
+    m_profileChanged[index] = 1;
+    m_hasPerformed = false;
+}
+
+void InterpolateCurveNetwork::ReplaceGuide(size_t index, const Handle(Geom_Curve)& guide)
+{
+    if (index >= m_inputGuides.size()) {
+        throw Error("Invalid guide index in InterpolateCurveNetwork::ReplaceGuide", geoml::INDEX_ERROR);
+    }
+    if (guide.IsNull()) {
+        throw Error("Null pointer guide in InterpolateCurveNetwork::ReplaceGuide", geoml::NULL_POINTER);
+    }
+
+    m_inputGuides[index] = prepareCurve(guide);
+    m_guideChanged[index] = 1;
+    m_hasPerformed = false;
 }
 
 
@@ -68,63 +117,129 @@ void InterpolateCurveNetwork::ComputeIntersections(math_Matrix& intersection_par
 {
     const std::vector<Handle(Geom_BSplineCurve)>& profiles = m_profiles;
     const std::vector<Handle(Geom_BSplineCurve)>& guides = m_guides;
-    
-    bool fail = false;
-    DEBUG_SCOPE(debug);
 
-    for (int spline_u_idx = 0; spline_u_idx < static_cast<int>(profiles.size()); ++spline_u_idx) {
-        for (int spline_v_idx = 0; spline_v_idx < static_cast<int>(guides.size()); ++spline_v_idx) {
-            std::vector<std::pair<double, double> > currentIntersections = BSplineAlgorithms::intersections(profiles[static_cast<size_t>(spline_u_idx)],
-                                                                                                                 guides[static_cast<size_t>(spline_v_idx)],
-                                                                                                                 m_spatialTol);
+    const int nProfiles = static_cast<int>(profiles.size());
+    const int nGuides = static_cast<int>(guides.size());
 
-            if (currentIntersections.size() < 1) {
-                fail = true;
-                debug.addShape(profiles[static_cast<size_t>(spline_u_idx)], "profile");
-                debug.addShape(guides[static_cast<size_t>(spline_v_idx)], "guide");
+    // The curves lie inside the convex hull of their control points. We enlarge these boxes
+    // by the intersection tolerance, such that pairs of curves with disjoint boxes can't intersect.
+    auto controlPolygonBox = [this](const Handle(Geom_BSplineCurve)& curve) {
+        Bnd_Box box;
+        for (int i = 1; i <= curve->NbPoles(); ++i) {
+            box.Add(curve->Pole(i));
+        }
+        box.Enlarge(m_spatialTol * BSplineAlgorithms::scale(curve));
+        return box;
+    };
+
+    std::vector<Bnd_Box> profileBoxes, guideBoxes;
+    profileBoxes.reserve(profiles.size());
+    guideBoxes.reserve(guides.size());
+    std::transform(profiles.begin(), profiles.end(), std::back_inserter(profileBoxes), controlPolygonBox);
+    std::transform(guides.begin(), guides.end(), std::back_inserter(guideBoxes), controlPolygonBox);
+
+    // the number of intersections for each pair of curves. Pairs that are not candidates have none.
+    std::vector<size_t> nIntersections(static_cast<size_t>(nProfiles * nGuides), 0);
+
+    // collect the pairs of curves that might intersect. Pairs of unchanged curves
+    // are taken from the previous run.
+    std::vector<std::pair<int, int>> candidates;
+    for (int spline_u_idx = 0; spline_u_idx < nProfiles; ++spline_u_idx) {
+        for (int spline_v_idx = 0; spline_v_idx < nGuides; ++spline_v_idx) {
+            const size_t pair_idx = static_cast<size_t>(spline_u_idx * nGuides + spline_v_idx);
+            if (!m_profileChanged[static_cast<size_t>(spline_u_idx)] && !m_guideChanged[static_cast<size_t>(spline_v_idx)]) {
+                intersection_params_u(spline_u_idx, spline_v_idx) = m_cachedIntersectionsU[pair_idx];
+                intersection_params_v(spline_u_idx, spline_v_idx) = m_cachedIntersectionsV[pair_idx];
+                nIntersections[pair_idx] = 1;
             }
-
-            else if (currentIntersections.size() == 1) {
-                intersection_params_u(spline_u_idx, spline_v_idx) = currentIntersections[0].first;
-                intersection_params_v(spline_u_idx, spline_v_idx) = currentIntersections[0].second;
+            else if (!profileBoxes[static_cast<size_t>(spline_u_idx)].IsOut(guideBoxes[static_cast<size_t>(spline_v_idx)])) {
+                candidates.push_back({spline_u_idx, spline_v_idx});
             }
-                // for closed curves
-            else if (currentIntersections.size() == 2) {
+        }
+    }
+
+    // Each pair writes only to its own entries of the parameter matrices, 
+    // hence the pairs can be intersected concurrently without locking.
+    // Exceptions must not leave the parallel loop, they are rethrown afterwards.
+    std::vector<std::exception_ptr> errors(candidates.size());
+    OSD_Parallel::For(0, static_cast<int>(candidates.size()), [&](int candidate_idx) {
+        const int spline_u_idx = candidates[static_cast<size_t>(candidate_idx)].first;
+        const int spline_v_idx = candidates[static_cast<size_t>(candidate_idx)].second;
+
+        std::vector<std::pair<double, double> > currentIntersections;
+        try {
+            currentIntersections = BSplineAlgorithms::intersections(profiles[static_cast<size_t>(spline_u_idx)],
+                                                                    guides[static_cast<size_t>(spline_v_idx)],
+                                                                    m_spatialTol);
+        }
+        catch (...) {
+            errors[static_cast<size_t>(candidate_idx)] = std::current_exception();
+            return;
+        }
 
-                // only the u-directional B-spline curves are closed
-                if (profiles[0]->IsClosed()) {
+        nIntersections[static_cast<size_t>(spline_u_idx * nGuides + spline_v_idx)] = currentIntersections.size();
 
-                    if (spline_v_idx == 0) {
-                        intersection_params_u(spline_u_idx, spline_v_idx) = std::min(currentIntersections[0].first, currentIntersections[1].first);
-                    }
-                    else if (spline_v_idx == static_cast<int>(guides.size() - 1)) {
-                        intersection_params_u(spline_u_idx, spline_v_idx) = std::max(currentIntersections[0].first, currentIntersections[1].first);
-                    }
+        if (currentIntersections.size() == 1) {
+            intersection_params_u(spline_u_idx, spline_v_idx) = currentIntersections[0].first;
+            intersection_params_v(spline_u_idx, spline_v_idx) = currentIntersections[0].second;
+        }
+            // for closed curves
+        else if (currentIntersections.size() == 2) {
 
-                    // intersection_params_vector[0].second == intersection_params_vector[1].second
-                    intersection_params_v(spline_u_idx, spline_v_idx) = currentIntersections[0].second;
-                }
+            // only the u-directional B-spline curves are closed
+            if (profiles[0]->IsClosed()) {
 
-                // only the v-directional B-spline curves are closed
-                if (guides[0]->IsClosed()) {
-
-                    if (spline_u_idx == 0) {
-                        intersection_params_v(spline_u_idx, spline_v_idx) = std::min(currentIntersections[0].second, currentIntersections[1].second);
-                    }
-                    else if (spline_u_idx == static_cast<int>(profiles.size() - 1)) {
-                        intersection_params_v(spline_u_idx, spline_v_idx) = std::max(currentIntersections[0].second, currentIntersections[1].second);
-                    }
-                    // intersection_params_vector[0].first == intersection_params_vector[1].first
-                    intersection_params_u(spline_u_idx, spline_v_idx) = currentIntersections[0].first;
+                if (spline_v_idx == 0) {
+                    intersection_params_u(spline_u_idx, spline_v_idx) = std::min(currentIntersections[0].first, currentIntersections[1].first);
+                }
+                else if (spline_v_idx == nGuides - 1) {
+                    intersection_params_u(spline_u_idx, spline_v_idx) = std::max(currentIntersections[0].first, currentIntersections[1].first);
                 }
 
-//                // TODO: both u-directional splines and v-directional splines are closed
-//               else if (intersection_params_vector.size() == 4) {
+                // intersection_params_vector[0].second == intersection_params_vector[1].second
+                intersection_params_v(spline_u_idx, spline_v_idx) = currentIntersections[0].second;
+            }
+
+            // only the v-directional B-spline curves are closed
+            if (guides[0]->IsClosed()) {
 
-//                }
+                if (spline_u_idx == 0) {
+                    intersection_params_v(spline_u_idx, spline_v_idx) = std::min(currentIntersections[0].second, currentIntersections[1].second);
+                }
+                else if (spline_u_idx == nProfiles - 1) {
+                    intersection_params_v(spline_u_idx, spline_v_idx) = std::max(currentIntersections[0].second, currentIntersections[1].second);
+                }
+                // intersection_params_vector[0].first == intersection_params_vector[1].first
+                intersection_params_u(spline_u_idx, spline_v_idx) = currentIntersections[0].first;
             }
 
-            else if (currentIntersections.size() > 2) {
+//            // TODO: both u-directional splines and v-directional splines are closed
+//           else if (intersection_params_vector.size() == 4) {
+
+//            }
+        }
+    });
+
+    for (const auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    // Evaluate the errors after the concurrent loop, as the debugging output is not thread safe
+    bool fail = false;
+    DEBUG_SCOPE(debug);
+
+    for (int spline_u_idx = 0; spline_u_idx < nProfiles; ++spline_u_idx) {
+        for (int spline_v_idx = 0; spline_v_idx < nGuides; ++spline_v_idx) {
+            size_t nCurrentIntersections = nIntersections[static_cast<size_t>(spline_u_idx * nGuides + spline_v_idx)];
+
+            if (nCurrentIntersections < 1) {
+                fail = true;
+                debug.addShape(profiles[static_cast<size_t>(spline_u_idx)], "profile");
+                debug.addShape(guides[static_cast<size_t>(spline_v_idx)], "guide");
+            }
+            else if (nCurrentIntersections > 2) {
                 throw geoml::Error("U-directional B-spline and v-directional B-spline have more than two intersections with each other!");
             }
         }
@@ -160,15 +275,15 @@ void InterpolateCurveNetwork::SortCurves(math_Matrix& intersection_params_u, mat
 
 void InterpolateCurveNetwork::MakeCurvesCompatible()
 {
-
-    // reparametrize into [0,1]
-    for (CurveArray::iterator it = m_profiles.begin(); it != m_profiles.end(); ++it) {
-        BSplineAlgorithms::reparametrizeBSpline(*(*it), 0., 1., 1e-15);
-    }
-
-    for (CurveArray::iterator it = m_guides.begin(); it != m_guides.end(); ++it) {
-        BSplineAlgorithms::reparametrizeBSpline(*(*it), 0., 1., 1e-15);
-    }
+    // Sorting and reparametrization modify the curves. Hence, we work on copies
+    // of the input curves, which are already reparametrized into [0,1]
+    auto copyCurve = [](const Handle(Geom_BSplineCurve)& curve) {
+        return Handle(Geom_BSplineCurve)::DownCast(curve->Copy());
+    };
+    m_profiles.clear();
+    m_guides.clear();
+    std::transform(m_inputProfiles.begin(), m_inputProfiles.end(), std::back_inserter(m_profiles), copyCurve);
+    std::transform(m_inputGuides.begin(), m_inputGuides.end(), std::back_inserter(m_guides), copyCurve);
     // now the parameter range of all  profiles and guides is [0, 1]
 
     int nGuides = static_cast<int>(m_guides.size());
@@ -181,6 +296,19 @@ void InterpolateCurveNetwork::MakeCurvesCompatible()
 
     ComputeIntersections(intersection_params_u, intersection_params_v);
 
+    // store the intersections for the next incremental update
+    m_cachedIntersectionsU.resize(static_cast<size_t>(nProfiles * nGuides));
+    m_cachedIntersectionsV.resize(static_cast<size_t>(nProfiles * nGuides));
+    for (int spline_u_idx = 0; spline_u_idx < nProfiles; ++spline_u_idx) {
+        for (int spline_v_idx = 0; spline_v_idx < nGuides; ++spline_v_idx) {
+            const size_t pair_idx = static_cast<size_t>(spline_u_idx * nGuides + spline_v_idx);
+            m_cachedIntersectionsU[pair_idx] = intersection_params_u(spline_u_idx, spline_v_idx);
+            m_cachedIntersectionsV[pair_idx] = intersection_params_v(spline_u_idx, spline_v_idx);
+        }
+    }
+    std::fill(m_profileChanged.begin(), m_profileChanged.end(), 0);
+    std::fill(m_guideChanged.begin(), m_guideChanged.end(), 0);
+
     // sort intersection_params_u and intersection_params_v and u-directional and v-directional B-spline curves
     SortCurves(intersection_params_u, intersection_params_v);
 
@@ -40,6 +40,10 @@ namespace geoml
  *  - Sort the profiles and guides
  *  - Reparametrize profiles and curves to make the network compatible (in most cases necessary)
  *  - Compute the gordon surface
+ *
+ * After a curve of the network has been replaced with ReplaceProfile or ReplaceGuide,
+ * the surface is updated incrementally: Only the intersections of the replaced curves
+ * are recomputed, all other intersections are taken from the previous run.
  */
 class InterpolateCurveNetwork
 {
@@ -74,6 +78,28 @@ public:
     /// Returns the u parameters of the final surface, that correspond to the guide curve locations
     GEOML_EXPORT std::vector<double> ParametersGuides();
 
+    /**
+     * @brief Replaces a profile of the network
+     *
+     * The next call to Surface() only recomputes the intersections of the new profile
+     * with the guides.
+     *
+     * @param index   Index of the profile in the order passed to the constructor
+     * @param profile The new profile curve
+     */
+    GEOML_EXPORT void ReplaceProfile(size_t index, const Handle(Geom_Curve)& profile);
+
+    /**
+     * @brief Replaces a guide of the network
+     *
+     * The next call to Surface() only recomputes the intersections of the new guide
+     * with the profiles.
+     *
+     * @param index Index of the guide in the order passed to the constructor
+     * @param guide The new guide curve
+     */
+    GEOML_EXPORT void ReplaceGuide(size_t index, const Handle(Geom_Curve)& guide);
+
 private:
     void Perform();
 
@@ -95,8 +121,18 @@ private:
     double m_spatialTol;
     
     typedef std::vector<Handle(Geom_BSplineCurve)> CurveArray;
+    // the input curves, reparametrized to [0,1]
+    CurveArray m_inputProfiles;
+    CurveArray m_inputGuides;
+    // the sorted and reparametrized curves of the last run
     CurveArray m_profiles;
     CurveArray m_guides;
+
+    // Intersection parameters of the last run in the order of the input curves.
+    // The parameters of the pair (i, j) are stored at i * nGuides + j.
+    std::vector<double> m_cachedIntersectionsU, m_cachedIntersectionsV;
+    // curves, whose intersections have to be recomputed
+    std::vector<char> m_profileChanged, m_guideChanged;
     std::vector<double> m_intersectionParamsU, m_intersectionParamsV;
     Handle(Geom_BSplineSurface) m_skinningSurfProfiles, m_skinningSurfGuides, m_tensorProdSurf, m_gordonSurf;
 };
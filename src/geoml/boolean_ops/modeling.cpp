@@ -1,15 +1,153 @@
 #include "boolean_ops/modeling.hpp"
 #include "topology/BRepBuilderAPI_MakeShape_Operation.hpp"
+#include "geoml/error.h"
+#include "boolean_operations/CIntersectionContext.h"
 
 #include "BRepAlgoAPI_Cut.hxx"
 #include "BRepAlgoAPI_Fuse.hxx"
+#include "BOPAlgo_PaveFiller.hxx"
+#include "TopTools_ListOfShape.hxx"
+
+#include <mutex>
+#include <vector>
+
+namespace {
+
+// each thread has its own default, such that concurrent scopes do not interfere
+geoml::BooleanOptions& default_options()
+{
+    thread_local geoml::BooleanOptions options;
+    return options;
+}
+
+BOPAlgo_GlueEnum to_occ(geoml::BooleanGlue glue)
+{
+    switch (glue) {
+    case geoml::BooleanGlue::shift:
+        return BOPAlgo_GlueShift;
+    case geoml::BooleanGlue::full:
+        return BOPAlgo_GlueFull;
+    default:
+        return BOPAlgo_GlueOff;
+    }
+}
+
+// returns the intersection of all inputs, which is shared by all boolean operations on the same inputs
+PIntersectionContext intersection_context(std::vector<geoml::Shape> const& inputs, geoml::BooleanOptions const& options)
+{
+    CIntersectionContext::Options context_options;
+    context_options.fuzzyValue = options.fuzzy_value;
+    context_options.runParallel = options.run_parallel;
+    context_options.useOBB = options.use_obb;
+    context_options.glue = to_occ(options.glue);
+    context_options.nonDestructive = options.non_destructive;
+
+    return CIntersectionContext::Get(std::vector<TopoDS_Shape>(inputs.begin(), inputs.end()), context_options);
+}
+
+// sets the arguments and options of the boolean operation and performs it
+// The algorithm must have been constructed with the intersection context of all arguments and tools.
+void build(BRepAlgoAPI_BooleanOperation& algo,
+           std::vector<geoml::Shape>::const_iterator argument_begin,
+           std::vector<geoml::Shape>::const_iterator tools_begin,
+           std::vector<geoml::Shape>::const_iterator tools_end,
+           geoml::BooleanOptions const& options)
+{
+    TopTools_ListOfShape arguments, tools;
+    for (auto it = argument_begin; it != tools_begin; ++it) {
+        arguments.Append(*it);
+    }
+    for (auto it = tools_begin; it != tools_end; ++it) {
+        tools.Append(*it);
+    }
+    algo.SetArguments(arguments);
+    algo.SetTools(tools);
+
+    algo.SetRunParallel(options.run_parallel);
+    algo.SetFuzzyValue(options.fuzzy_value);
+    algo.SetUseOBB(options.use_obb);
+    algo.SetGlue(to_occ(options.glue));
+    algo.SetCheckInverted(options.check_inverted);
+    algo.SetNonDestructive(options.non_destructive);
+
+    algo.Build();
+}
+
+} // namespace
 
 namespace geoml{
 
+BooleanOptions default_boolean_options()
+{
+    return default_options();
+}
+
+void set_default_boolean_options(BooleanOptions const& options)
+{
+    default_options() = options;
+}
+
+ScopedBooleanOptions::ScopedBooleanOptions(BooleanOptions const& options)
+    : m_previous(default_boolean_options())
+{
+    set_default_boolean_options(options);
+}
+
+ScopedBooleanOptions::~ScopedBooleanOptions()
+{
+    set_default_boolean_options(m_previous);
+}
+
+void enable_intersection_cache(size_t max_entries)
+{
+    CIntersectionContextCache::Instance().SetMaxEntries(max_entries);
+}
+
+void disable_intersection_cache()
+{
+    CIntersectionContextCache::Instance().SetMaxEntries(0);
+}
+
+void clear_intersection_cache()
+{
+    CIntersectionContextCache::Instance().Clear();
+}
+
 Shape boolean_subtract (Shape const& shape, Shape const& cutting_tool)
 {
-    BRepAlgoAPI_Cut cutter(shape, cutting_tool);
-    auto operation = BRepBuilderAPI_MakeShape_Operation(cutter, {shape, cutting_tool});
+    return boolean_subtract(shape, cutting_tool, default_boolean_options());
+}
+
+
+Shape boolean_subtract (Shape const& shape, Shape const& cutting_tool, BooleanOptions const& options)
+{
+    return boolean_subtract(shape, std::vector<Shape>{cutting_tool}, options);
+}
+
+
+Shape boolean_subtract (Shape const& shape, std::vector<Shape> const& cutting_tools)
+{
+    return boolean_subtract(shape, cutting_tools, default_boolean_options());
+}
+
+
+Shape boolean_subtract (Shape const& shape, std::vector<Shape> const& cutting_tools, BooleanOptions const& options)
+{
+    if (cutting_tools.empty()) {
+        return shape;
+    }
+
+    std::vector<Shape> inputs;
+    inputs.reserve(cutting_tools.size() + 1);
+    inputs.push_back(shape);
+    inputs.insert(inputs.end(), cutting_tools.begin(), cutting_tools.end());
+
+    PIntersectionContext context = intersection_context(inputs, options);
+    std::unique_lock<std::recursive_mutex> lock = context->Lock();
+
+    BRepAlgoAPI_Cut cutter(context->Filler());
+    build(cutter, inputs.begin(), inputs.begin() + 1, inputs.end(), options);
+    auto operation = BRepBuilderAPI_MakeShape_Operation(cutter, inputs);
     return operation.value();
 }
 
@@ -22,8 +160,38 @@ Shape operator-(Shape const& shape, Shape const& cutting_tool)
 
 Shape boolean_union(Shape const& shape_1, Shape const& shape_2)
 {
-    BRepAlgoAPI_Fuse fuser(shape_1, shape_2);
-    auto operation = BRepBuilderAPI_MakeShape_Operation(fuser, {shape_1, shape_2});
+    return boolean_union(shape_1, shape_2, default_boolean_options());
+}
+
+
+Shape boolean_union(Shape const& shape_1, Shape const& shape_2, BooleanOptions const& options)
+{
+    return boolean_union(std::vector<Shape>{shape_1, shape_2}, options);
+}
+
+
+Shape boolean_union(std::vector<Shape> const& shapes)
+{
+    return boolean_union(shapes, default_boolean_options());
+}
+
+
+Shape boolean_union(std::vector<Shape> const& shapes, BooleanOptions const& options)
+{
+    if (shapes.empty()) {
+        throw Error("No shapes given in boolean_union");
+    }
+    if (shapes.size() == 1) {
+        return shapes.front();
+    }
+
+    // the first shape is the argument, all others are tools of the fuse operation
+    PIntersectionContext context = intersection_context(shapes, options);
+    std::unique_lock<std::recursive_mutex> lock = context->Lock();
+
+    BRepAlgoAPI_Fuse fuser(context->Filler());
+    build(fuser, shapes.begin(), shapes.begin() + 1, shapes.end(), options);
+    auto operation = BRepBuilderAPI_MakeShape_Operation(fuser, shapes);
     return operation.value();
 }
 
@@ -36,4 +204,3 @@ Shape operator+(Shape const& shape_1, Shape const& shape_2)
 
 
 } // namespace geoml
-
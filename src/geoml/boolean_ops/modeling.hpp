@@ -10,6 +10,99 @@
 namespace geoml
 {
 
+/**
+ * @brief Gluing mode of the boolean operations, see BOPAlgo_GlueEnum
+ */
+enum class BooleanGlue
+{
+    off,   ///< no gluing
+    shift, ///< the arguments are only touching or overlapping (partially coinciding faces)
+    full   ///< the arguments are only touching or sharing coinciding faces
+};
+
+/**
+ * @brief Options of the boolean operations
+ */
+struct BooleanOptions
+{
+    /// Use the parallel mode of the OpenCASCADE boolean operations
+    bool run_parallel = false;
+
+    /// Additional tolerance of the operation, which allows to treat nearly coincident geometries as coincident
+    double fuzzy_value = 0.;
+
+    /// Use oriented bounding boxes to filter the pairs of intersecting subshapes
+    bool use_obb = false;
+
+    /// Gluing mode for arguments with coinciding subshapes
+    BooleanGlue glue = BooleanGlue::off;
+
+    /// Check the input solids for inverted status
+    bool check_inverted = true;
+
+    /// If true, the input shapes are not modified by the operation
+    bool non_destructive = false;
+};
+
+/**
+ * @brief Returns the options used by the boolean operations of the calling thread,
+ * if no options are given explicitly
+ *
+ * The default options are thread local. Each thread starts with default constructed options.
+ */
+GEOML_API_EXPORT BooleanOptions default_boolean_options();
+
+/**
+ * @brief Sets the options used by the boolean operations of the calling thread,
+ * if no options are given explicitly
+ *
+ * This includes the operators + and -. Other threads are not affected.
+ */
+GEOML_API_EXPORT void set_default_boolean_options(BooleanOptions const& options);
+
+/**
+ * @brief Sets the default boolean options for the lifetime of this object
+ *
+ * The previous default options are restored on destruction. Only the
+ * default options of the calling thread are changed.
+ */
+class ScopedBooleanOptions
+{
+public:
+    GEOML_API_EXPORT explicit ScopedBooleanOptions(BooleanOptions const& options);
+    GEOML_API_EXPORT ~ScopedBooleanOptions();
+
+    ScopedBooleanOptions(ScopedBooleanOptions const&) = delete;
+    ScopedBooleanOptions& operator=(ScopedBooleanOptions const&) = delete;
+
+private:
+    BooleanOptions m_previous;
+};
+
+/**
+ * @brief Enables the cache of the intersections of the boolean operations
+ *
+ * If enabled, the boolean operations cache the intersection of the most recently
+ * used inputs. Hence, e.g. the union and the subtraction of the same shapes intersect
+ * the shapes only once. The inputs are compared by their identity. The cache keeps
+ * the input shapes alive until they are released.
+ *
+ * The cache is disabled by default.
+ *
+ * @param max_entries Maximum number of cached intersections
+ */
+GEOML_API_EXPORT void enable_intersection_cache(size_t max_entries=8);
+
+/**
+ * @brief Disables the cache of the intersections and releases the cached intersections
+ */
+GEOML_API_EXPORT void disable_intersection_cache();
+
+/**
+ * @brief Releases the cached intersections of the boolean operations
+ */
+GEOML_API_EXPORT void clear_intersection_cache();
+
 /**
  * @brief A function that subracts a Shape (cutting tool) from a Shape. This function has a history mapping.
  * 
@@ -19,6 +112,36 @@ namespace geoml
  */
 Shape boolean_subtract(Shape const& shape, Shape const& cutting_tool);
 
+/**
+ * @brief A function that subracts a Shape (cutting tool) from a Shape. This function has a history mapping.
+ * 
+ * 
+ * @param shape The Shape from which the cutting tool should be subtracted
+ * @param cutting_tool The Shape that is the cutting tool
+ * @param options Options of the boolean operation
+ */
+Shape boolean_subtract(Shape const& shape, Shape const& cutting_tool, BooleanOptions const& options);
+
+/**
+ * @brief A function that subracts multiple cutting tools from a Shape. This function has a history mapping.
+ *
+ * All cutting tools are intersected with the shape in a single operation, which is much
+ * faster than subtracting the tools one after another.
+ *
+ * @param shape The Shape from which the cutting tools should be subtracted
+ * @param cutting_tools The Shapes that are the cutting tools
+ */
+Shape boolean_subtract(Shape const& shape, std::vector<Shape> const& cutting_tools);
+
+/**
+ * @brief A function that subracts multiple cutting tools from a Shape. This function has a history mapping.
+ *
+ * @param shape The Shape from which the cutting tools should be subtracted
+ * @param cutting_tools The Shapes that are the cutting tools
+ * @param options Options of the boolean operation
+ */
+Shape boolean_subtract(Shape const& shape, std::vector<Shape> const& cutting_tools, BooleanOptions const& options);
+
 /**
  * @brief A function that subracts a Shape (cutting tool) from a Shape. This function has a history mapping.
  * 
@@ -37,6 +160,34 @@ Shape operator-(Shape const& shape, Shape const& cutting_tool);
  */
 Shape boolean_union(Shape const& shape_1, Shape const& shape_2);
 
+/**
+ * @brief A function that returns the boolean union of two Shapes. This function has a history mapping.
+ * 
+ * 
+ * @param shape_1 The first Shape
+ * @param shape_2 The second Shape
+ * @param options Options of the boolean operation
+ */
+Shape boolean_union(Shape const& shape_1, Shape const& shape_2, BooleanOptions const& options);
+
+/**
+ * @brief A function that returns the boolean union of multiple Shapes. This function has a history mapping.
+ *
+ * All shapes are intersected with each other in a single operation, which is much
+ * faster than fusing the shapes one after another.
+ *
+ * @param shapes The Shapes to fuse
+ */
+Shape boolean_union(std::vector<Shape> const& shapes);
+
+/**
+ * @brief A function that returns the boolean union of multiple Shapes. This function has a history mapping.
+ *
+ * @param shapes The Shapes to fuse
+ * @param options Options of the boolean operation
+ */
+Shape boolean_union(std::vector<Shape> const& shapes, BooleanOptions const& options);
+
 /**
  * @brief A function that returns the boolean union of two Shapes. This function has a history mapping.
  * 
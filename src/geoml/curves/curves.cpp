@@ -1,6 +1,7 @@
 #include "curves/curves.h"
 #include <Geom_BSplineCurve.hxx>
 #include "geometry/PointsToBSplineInterpolation.h"
+#include "geometry/BSplineAlgorithms.h"
 #include "common/CommonFunctions.h"
 
 
@@ -36,5 +37,26 @@ Handle(Geom_BSplineCurve) interpolate_points_to_b_spline_curve(const std::vector
     }
 }
 
+std::vector<Handle(Geom_BSplineCurve)> interpolate_points_to_b_spline_curves(const std::vector<std::vector<gp_Pnt>> &point_sets, int degree, bool continuousIfClosed, const std::vector<Standard_Real> &parameters)
+{
+    std::vector<Handle(TColgp_HArray1OfPnt)> point_cols;
+    point_cols.reserve(point_sets.size());
+    for (const auto& points : point_sets) {
+        point_cols.push_back(OccArray(points));
+    }
+
+    if (point_cols.empty()) {
+        return {};
+    }
+
+    if (parameters.size() == 0) {
+        std::vector<double> params = BSplineAlgorithms::computeParamsBSplineCurve(point_cols.front());
+        return PointsToBSplineInterpolation::Curves(point_cols, params, degree, continuousIfClosed);
+    }
+    else {
+        return PointsToBSplineInterpolation::Curves(point_cols, parameters, degree, continuousIfClosed);
+    }
+}
+
 } // namespace geoml
 
@@ -47,4 +47,18 @@ nurbs_curve(
 GEOML_API_EXPORT Handle(Geom_BSplineCurve)
 interpolate_points_to_b_spline_curve(const std::vector<gp_Pnt> &points, int degree = 3, bool continuousIfClosed = false, const std::vector<Standard_Real> &parameters = std::vector<Standard_Real>());
 
+/**
+ * @brief Interpolates several point sets with a common parameterization to B-spline curves
+ *
+ * This is much faster than interpolating each point set individually, as the
+ * interpolation system is set up and factorized only once.
+ *
+ * @param point_sets The point sets to be interpolated. All point sets must have the same number of points.
+ * @param degree The degree of the B-spline curves
+ * @param continuousIfClosed Creates continuous curves for closed point sets
+ * @param parameters The common parameters of the points. If empty, they are computed from the first point set.
+ */
+GEOML_API_EXPORT std::vector<Handle(Geom_BSplineCurve)>
+interpolate_points_to_b_spline_curves(const std::vector<std::vector<gp_Pnt>> &point_sets, int degree = 3, bool continuousIfClosed = false, const std::vector<Standard_Real> &parameters = std::vector<Standard_Real>());
+
 } // namespace geoml
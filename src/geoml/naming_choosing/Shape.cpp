@@ -4,6 +4,13 @@
 #include <TopExp_Explorer.hxx>
 
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <unordered_set>
 #include <string>
 
 namespace geoml {
@@ -11,9 +18,13 @@ namespace geoml {
 namespace details {
 
 std::size_t ShapeHasher::operator()(Shape const& s) const
+{
+    return (*this)(s.shape());
+}
+
+std::size_t ShapeHasher::operator()(TopoDS_Shape const& occt_shape) const
 {
     // Use the address of TShape and the hash of the Location
-    TopoDS_Shape occt_shape = s;
     const void* tShapePtr = occt_shape.TShape().get();
     std::size_t tShapeHash = std::hash<const void*>{}(tShapePtr);
     std::size_t locationHash = occt_shape.Location().HashCode(std::numeric_limits<int>::max());
@@ -25,8 +36,182 @@ bool ShapeIsSame::operator()(Shape const& l, Shape const& r) const
     return l.is_same(r);
 }
 
+bool ShapeIsSame::operator()(TopoDS_Shape const& l, TopoDS_Shape const& r) const
+{
+    return l.IsSame(r);
+}
+
 } // namespace details 
 
+namespace {
+
+// incremented whenever an origin is added to a shape
+std::atomic<std::uint64_t> history_generation {0};
+
+// the next id of a shape node
+std::atomic<std::uint64_t> next_id {0};
+
+const int no_path = std::numeric_limits<int>::max();
+
+// hashes TShape, location and orientation of a shape
+struct OrientedShapeHasher
+{
+    std::size_t operator()(TopoDS_Shape const& s) const
+    {
+        return details::ShapeHasher{}(s) ^ (static_cast<std::size_t>(s.Orientation()) << 2);
+    }
+};
+
+struct OrientedShapeIsEqual
+{
+    bool operator()(TopoDS_Shape const& l, TopoDS_Shape const& r) const
+    {
+        return l.IsEqual(r);
+    }
+};
+
+// the global table of interned tags
+struct TagTable
+{
+    std::shared_mutex mutex; /** tags are looked up much more often than they are added */
+    std::unordered_map<std::string, TagId> ids;
+};
+
+TagTable& tag_table()
+{
+    static TagTable table;
+    return table;
+}
+
+// returns the id of a tag, if it has been interned already
+std::pair<TagId, bool> find_tag(std::string const& tag)
+{
+    TagTable& table = tag_table();
+    std::shared_lock<std::shared_mutex> guard(table.mutex);
+    auto it = table.ids.find(tag);
+    if (it == table.ids.end()) {
+        return {0, false};
+    }
+    return {it->second, true};
+}
+
+} // namespace
+
+TagId intern_tag(std::string const& tag)
+{
+    auto id = find_tag(tag);
+    if (id.second) {
+        return id.first;
+    }
+
+    TagTable& table = tag_table();
+    std::unique_lock<std::shared_mutex> guard(table.mutex);
+    return table.ids.emplace(tag, static_cast<TagId>(table.ids.size())).first->second;
+}
+
+
+struct Shape::HistoryCache
+{
+    /**
+     * @brief returns the minimum number of modeling steps from shape
+     * to any ancestor that is the same as target, or no_path.
+     *
+     * The distances of all visited ancestors are memoized, such that each
+     * node of the history graph is visited only once per target.
+     */
+    int distance(Shape const& shape, TopoDS_Shape const& target)
+    {
+        auto it = distances.find(shape.m_data->id);
+        if (it != distances.end()) {
+            return it->second;
+        }
+
+        if (shape.is_same(target)) {
+            distances[shape.m_data->id] = 0;
+            return 0;
+        }
+
+        // marks the shape as visited in case of cycles in the history
+        distances[shape.m_data->id] = no_path;
+
+        int result = no_path;
+        for (auto const& origin : shape.m_data->attributes->origins) {
+            int d = distance(origin, target);
+            if (d != no_path) {
+                result = std::min(result, d + 1);
+            }
+        }
+        distances[shape.m_data->id] = result;
+        return result;
+    }
+
+    std::uint64_t generation = 0; /** the history generation, the cache is valid for */
+    std::unordered_map<std::uint64_t, int> distances; /** the distances by shape node id */
+};
+
+struct Shape::SubshapeTable
+{
+    /**
+     * @brief returns the shape wrapping the given subshape. A new node is
+     * created, if the subshape has not been wrapped before or if its node
+     * does not exist anymore.
+     */
+    Shape intern(std::shared_ptr<SubshapeTable> const& self, TopoDS_Shape const& subshape)
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+
+        auto& node = nodes[subshape];
+        if (auto data = node.lock()) {
+            return Shape(std::move(data));
+        }
+
+        // other orientations of the subshape share their history and tags
+        auto& attributes_node = attributes[subshape];
+        auto attributes_of_same = attributes_node.lock();
+        if (!attributes_of_same) {
+            attributes_of_same = std::make_shared<Data::Attributes>();
+            attributes_node = attributes_of_same;
+        }
+
+        Shape shape(std::make_shared<Data>(subshape, std::move(attributes_of_same)));
+        shape.m_data->subshape_table = self;
+        node = shape.m_data;
+        return shape;
+    }
+
+    std::mutex mutex; /** guards the nodes, as subshapes might be materialized concurrently */
+
+    std::atomic<std::uint64_t> version {0}; /** incremented whenever the children of a node might have been modified */
+
+    // The nodes are not owned by the table, as the nodes own the table
+    std::unordered_map<TopoDS_Shape, std::weak_ptr<Data>, OrientedShapeHasher, OrientedShapeIsEqual> nodes;
+    details::ShapeMap<std::weak_ptr<Data::Attributes>> attributes; /** the shared attributes of the nodes by is_same */
+};
+
+std::shared_ptr<Shape::SubshapeTable> Shape::subshape_table_of(Data& data)
+{
+    std::lock_guard<std::mutex> guard(data.subshape_table_mutex);
+    if (!data.subshape_table) {
+        // this is the root of a topology tree
+        data.subshape_table = std::make_shared<SubshapeTable>();
+    }
+    return data.subshape_table;
+}
+
+std::vector<Shape> Shape::make_children(Data& data)
+{
+    std::shared_ptr<SubshapeTable> table = subshape_table_of(data);
+
+    std::vector<Shape> children;
+    for (TopoDS_Iterator it(data.shape); it.More(); it.Next()) {
+        children.push_back(table->intern(table, it.Value()));
+    }
+    return children;
+}
+
+Shape::Shape(std::shared_ptr<Data> data)
+    : m_data(std::move(data))
+{}
 
 Shape::Shape(TopoDS_Shape const& theShape)
     : m_data(std::make_shared<Data>(theShape))
@@ -46,38 +231,38 @@ TopoDS_Shape Shape::shape() const {
 
 std::vector<Shape> const& Shape::direct_subshapes() const
 {
-    return m_data->children;
+    return m_data->get_children();
 }
 
 Shape::const_iterator Shape::begin() const 
 {
-    return m_data->children.begin();
+    return m_data->get_children().begin();
 }
 
 Shape::iterator Shape::begin() 
 {
-    return m_data->children.begin();
+    return m_data->get_children().begin();
 }
 
 Shape::const_iterator Shape::end() const
 {
-    return m_data->children.end();
+    return m_data->get_children().end();
 }
 
 Shape::iterator const Shape::end()
 {
-    return m_data->children.end();
+    return m_data->get_children().end();
 }
 
 
 Shape const& Shape::operator[](int i) const 
 {
-    return m_data->children[i];
+    return m_data->get_children()[i];
 }
 
 Shape& Shape::operator[](int i) 
 {
-    return m_data->children[i];
+    return m_data->get_children()[i];
 }
 
 size_t Shape::size() const
@@ -86,7 +271,7 @@ size_t Shape::size() const
         return 0;
     }
     if (m_data->shape.ShapeType() == TopAbs_COMPOUND) {
-        return m_data->children.size();
+        return m_data->get_children().size();
     }
     return 1;
 }
@@ -103,12 +288,142 @@ bool Shape::is_empty() const
 
 std::vector<Shape>& Shape::direct_subshapes()
 {
-    return m_data->children;
+    return m_data->get_children();
+}
+
+void Shape::set_direct_subshapes(std::vector<Shape> children)
+{
+    m_data->set_children(std::move(children));
 }
 
 Shape Shape::get_subshapes() const
 {
-    return select_subshapes([](auto&&){ return true; });
+    std::shared_ptr<const SubshapeIndex> index = subshape_index();
+
+    std::vector<Shape> subshapes;
+    subshapes.reserve(index->first.size());
+    for (size_t inode : index->first) {
+        subshapes.push_back(index->node(*this, inode));
+    }
+    return make_compound(std::move(subshapes));
+}
+
+Shape Shape::get_subshapes_of_type(TopAbs_ShapeEnum shape_type) const
+{
+    std::shared_ptr<const SubshapeIndex> index = subshape_index();
+
+    std::vector<Shape> subshapes;
+    auto const& ids = index->ids_by_type[shape_type];
+    subshapes.reserve(ids.size());
+    for (size_t id : ids) {
+        subshapes.push_back(index->node(*this, index->first[id]));
+    }
+    return make_compound(std::move(subshapes));
+}
+
+namespace {
+
+// returns true, if none of the subshape tables of the index has been modified
+template <typename Index>
+bool is_up_to_date(Index const& index)
+{
+    for (auto const& version : index.versions) {
+        if (version.first->version.load(std::memory_order_acquire) != version.second) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+std::shared_ptr<const Shape::SubshapeIndex> Shape::subshape_index() const
+{
+    std::lock_guard<std::mutex> guard(m_data->subshape_index_mutex);
+
+    if (m_data->subshape_index && is_up_to_date(*m_data->subshape_index)) {
+        return m_data->subshape_index;
+    }
+
+    auto index = std::make_shared<SubshapeIndex>();
+    index->ids_by_type.resize(TopAbs_SHAPE + 1);
+
+    // the version of each table is recorded before the children of its nodes are read
+    std::unordered_set<SubshapeTable const*> tables;
+
+    // the last node of each distinct subshape to link the next occurrences
+    std::vector<size_t> last;
+
+    // depth first traversal in the same order as accept_topology_visitor
+    std::vector<std::pair<Shape, int>> stack;
+    stack.emplace_back(*this, 0);
+    while (!stack.empty()) {
+        Shape shape = std::move(stack.back().first);
+        int depth = stack.back().second;
+        stack.pop_back();
+
+        std::shared_ptr<SubshapeTable> table = subshape_table_of(*shape.m_data);
+        if (tables.insert(table.get()).second) {
+            std::uint64_t version = table->version.load(std::memory_order_acquire);
+            index->versions.emplace_back(std::move(table), version);
+        }
+
+        size_t id = index->first.size();
+        if (!shape.is_null()) {
+            auto inserted = index->ids_by_shape.emplace(shape.shape(), id);
+            if (inserted.second) {
+                index->ids_by_type[shape.shape().ShapeType()].push_back(id);
+            }
+            id = inserted.first->second;
+        }
+        if (id == index->first.size()) {
+            index->first.push_back(index->nodes.size());
+            last.push_back(index->nodes.size());
+        }
+        else {
+            index->next[last[id]] = index->nodes.size();
+            last[id] = index->nodes.size();
+        }
+        index->next.push_back(SubshapeIndex::npos);
+
+        // the shape itself is not stored to avoid a reference cycle
+        index->nodes.push_back(index->nodes.empty() ? Shape(TopoDS_Shape()) : shape);
+        index->depths.push_back(depth);
+        index->height = std::max(index->height, depth);
+        index->ids.push_back(id);
+
+        auto const& children = shape.m_data->get_children();
+        for (auto it = children.rbegin(); it != children.rend(); ++it) {
+            stack.emplace_back(*it, depth + 1);
+        }
+    }
+
+    m_data->subshape_index = index;
+    return index;
+}
+
+void Shape::invalidate_subshape_indices(Data& data)
+{
+    subshape_table_of(data)->version.fetch_add(1, std::memory_order_acq_rel);
+}
+
+Shape Shape::make_compound(std::vector<Shape>&& shapes)
+{
+    TopoDS_Compound compound;
+    BRep_Builder builder;
+    builder.MakeCompound(compound);
+    for (auto const& s : shapes) {
+        builder.Add(compound, s);
+    }
+    Shape result{compound};
+
+    // In the Shape constructor, new Shape instances would be added as children
+    // from the TopoDS_Shape instances stored in the compound. These do not 
+    // yet have any historical data associated to them. To retain the historical
+    // modeling connections, we use the given shapes as children.
+    result.m_data->init_children(std::move(shapes));
+
+    return result;
 }
 
 Shape Shape::unique_element() const 
@@ -116,17 +431,17 @@ Shape Shape::unique_element() const
     if (m_data->shape.ShapeType() != TopAbs_COMPOUND) {
         throw Error("unique_element: The shape is not a compound.");
     }
-    if (m_data->children.size() != 1) {
-        throw Error(std::string("unique_element only works for shapes with exactly one child. This shape has ") + std::to_string(m_data->children.size()) + " children.");
+    if (m_data->get_children().size() != 1) {
+        throw Error(std::string("unique_element only works for shapes with exactly one child. This shape has ") + std::to_string(m_data->get_children().size()) + " children.");
     }
 
-    return m_data->children[0];
+    return m_data->get_children()[0];
 }
 
 Shape Shape::unique_element_or(Shape const& other) const 
 {
-    if (m_data->shape.ShapeType() == TopAbs_COMPOUND && m_data->children.size() == 1) {
-        return m_data->children[0];
+    if (m_data->shape.ShapeType() == TopAbs_COMPOUND && m_data->get_children().size() == 1) {
+        return m_data->get_children()[0];
     }
     return other;
 }
@@ -136,6 +451,11 @@ bool Shape::is_type(TopAbs_ShapeEnum shape_type) const
     return m_data->shape.ShapeType() == shape_type;
 }
 
+TopAbs_ShapeEnum Shape::shape_type() const
+{
+    return m_data->shape.ShapeType();
+}
+
 bool Shape::is_same(Shape const& other) const
 {
     return is_same(other.m_data->shape);
@@ -149,102 +469,175 @@ bool Shape::is_same(TopoDS_Shape const& other) const
 
 bool Shape::has_subshape(Shape const& shape) const
 {
-    return has_subshape_that([=](Shape const& s) { return s.is_same(shape); });
+    if (shape.is_null()) {
+        return has_subshape_that([=](Shape const& s) { return s.is_same(shape); });
+    }
+    return subshape_index()->ids_by_shape.count(shape.shape()) > 0;
 }
 
 bool Shape::has_origin() const
 {
-    return m_data->origins.size() > 0;
+    return m_data->attributes->origins.size() > 0;
 }
 
 bool Shape::is_unmodified_descendent_of(Shape const& other, int max_depth) const
 {
-    return is_same(other) && is_descendent_of(other);
+    return is_same(other) && is_descendent_of(other, max_depth);
 }
 
 bool Shape::is_unmodified_descendent_of_subshape_in(Shape const& other, int max_depth) const
 {
-    for (auto const& other_subshape : other.get_subshapes()) {
-        if (is_unmodified_descendent_of(other_subshape, max_depth)) {
-            return true;
-        }
+    // an unmodified descendent is the same shape as its ancestor, i.e. the
+    // shape itself at depth 0 of the history is the ancestor
+    if (max_depth < 0) {
+        return false;
     }
-    return false;
+    return other.has_subshape(*this);
 }
 
 bool Shape::is_modified_descendent_of(Shape const& other, int max_depth) const
 {
-    return !is_same(other) && is_descendent_of(other);
+    return !is_same(other) && is_descendent_of(other, max_depth);
 }
 
 bool Shape::is_modified_descendent_of_subshape_in(Shape const& other, int max_depth) const
 {
-    for (auto const& other_subshape : other.get_subshapes()) {
-        if (is_modified_descendent_of(other_subshape, max_depth)) {
-            return true;
-        }
-    }
-    return false;
+    std::shared_ptr<const SubshapeIndex> index = other.subshape_index();
+    return visit_ancestors(max_depth, [&](Shape const& ancestor) {
+        return !ancestor.is_null() && !ancestor.is_same(*this) && index->ids_by_shape.count(ancestor.shape()) > 0;
+    });
 }
 
 bool Shape::is_descendent_of_subshape_in(Shape const& other, int max_depth) const
 {
-    return other.has_subshape_that([=](Shape const& s){ return s.is_ancestor_of(*this); });
+    std::shared_ptr<const SubshapeIndex> index = other.subshape_index();
+    return visit_ancestors(max_depth, [&](Shape const& ancestor) {
+        return !ancestor.is_null() && index->ids_by_shape.count(ancestor.shape()) > 0;
+    });
 }
 
 bool Shape::is_descendent_of(Shape const& other, int max_depth) const
 {
-    details::FindIfVisitor v(
-        [&](Shape const& shape){ return shape.is_same(other); },
-        max_depth
-        );
-    accept_history_visitor(v);
-    return v.found;
+    if (max_depth < 0) {
+        return false;
+    }
+
+    // The distances of all visited shapes to other are stored in the cache
+    // of other, as typically many shapes are checked against the same shape.
+    std::lock_guard<std::mutex> guard(other.m_data->history_cache_mutex);
+    std::uint64_t generation = history_generation.load(std::memory_order_acquire);
+    auto& cache = other.m_data->history_cache;
+    if (!cache || cache->generation != generation) {
+        cache = std::make_shared<HistoryCache>();
+        cache->generation = generation;
+    }
+
+    return cache->distance(*this, other.shape()) <= max_depth;
 }
 
 bool Shape::is_ancestor_of(Shape const& other, int max_depth) const
 {
-    return other.is_descendent_of(*this);
+    return other.is_descendent_of(*this, max_depth);
+}
+
+bool Shape::visit_ancestors(int max_depth, std::function<bool(Shape const&)> const& f) const
+{
+    if (max_depth < 0) {
+        return false;
+    }
+
+    std::unordered_set<std::uint64_t> visited {m_data->id};
+    std::vector<Shape const*> current {this};
+    std::vector<Shape const*> next;
+    for (int depth = 0; !current.empty(); ++depth) {
+        for (Shape const* shape : current) {
+            if (f(*shape)) {
+                return true;
+            }
+            if (depth < max_depth) {
+                for (auto const& origin : shape->m_data->attributes->origins) {
+                    if (visited.insert(origin.m_data->id).second) {
+                        next.push_back(&origin);
+                    }
+                }
+            }
+        }
+        current.swap(next);
+        next.clear();
+    }
+    return false;
+}
+
+std::uint64_t Shape::next_node_id()
+{
+    return next_id.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Shape::invalidate_history_caches()
+{
+    history_generation.fetch_add(1, std::memory_order_acq_rel);
 }
 
 bool Shape::has_tag(std::string const& tag) const
 {
-    return std::find_if(
-           m_data->persistent_meta_tags.begin(),
-           m_data->persistent_meta_tags.end(),
-           [&](auto const& s){ return s == tag; }
-           ) != m_data->persistent_meta_tags.end(); 
+    auto id = find_tag(tag);
+    return id.second && has_tag(id.first);
+}
+
+bool Shape::has_tag(TagId tag) const
+{
+    auto const& tags = m_data->attributes->persistent_meta_tags;
+    return std::binary_search(tags.begin(), tags.end(), tag);
 }
 
 std::vector<TagTrack>& Shape::get_tag_tracks()
 {
-    return m_data->tag_tracks;
+    return m_data->attributes->tag_tracks;
 }
 
 const std::vector<TagTrack>& Shape::get_tag_tracks() const
 {
-    return m_data->tag_tracks;
+    return m_data->attributes->tag_tracks;
 }
 
 void Shape::add_meta_tag(std::string const& tag) 
 {
-    m_data->persistent_meta_tags.push_back(tag);
+    add_meta_tag(intern_tag(tag));
+}
+
+void Shape::add_meta_tag(TagId tag)
+{
+    auto& tags = m_data->attributes->persistent_meta_tags;
+    auto it = std::lower_bound(tags.begin(), tags.end(), tag);
+    if (it == tags.end() || *it != tag) {
+        tags.insert(it, tag);
+    }
 }
 
 void Shape::add_tag_track(TagTrack const& tt)
 {
-    m_data->tag_tracks.push_back(tt);
+    m_data->attributes->tag_tracks.push_back(tt);
 }
 
 void Shape::apply_tag_tracks()
 {
+    if (m_data->attributes->tag_tracks.empty()) {
+        return;
+    }
+
+    std::vector<TagId> tags;
+    for (auto const& tag_track : m_data->attributes->tag_tracks) {
+        tags.push_back(intern_tag(tag_track.m_tag));
+    }
+
     for(auto &subshape : get_subshapes()) //TODO: A for each would be cool
     {
-        for(auto const& tag_track : m_data->tag_tracks)
+        for (size_t i = 0; i < tags.size(); ++i)
         {
+            auto const& tag_track = m_data->attributes->tag_tracks[i];
             if(tag_track.m_remainingSteps > 0 && tag_track.m_criterion(subshape))
             {
-                subshape.add_meta_tag(tag_track.m_tag);
+                subshape.add_meta_tag(tags[i]);
             }
         }
     }
@@ -3,6 +3,7 @@
 #include "geoml/geoml.h"
 #include "geoml/error.h"
 
+#include <algorithm>
 #include <limits>
 #include <stdexcept>
 #include <vector>
@@ -10,11 +11,16 @@
 #include <string>
 #include <functional>
 #include <unordered_set>
+#include <unordered_map>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
 
 #include <TopoDS_Compound.hxx>
 #include <BRep_Builder.hxx>
 #include <TopoDS_Shape.hxx>
 #include <TopoDS_Iterator.hxx>
+#include <TopAbs_ShapeEnum.hxx>
 
 
 namespace geoml {
@@ -27,24 +33,79 @@ class Operation;
 
 class Shape;
 
+namespace details {
+
+/**
+ * @brief The PredicateExpression is the expression tree of a ShapePredicate,
+ * see predicate_functions.cpp
+ */
+struct PredicateExpression;
+
+/**
+ * @brief a bit mask containing all values of TopAbs_ShapeEnum
+ */
+const std::uint32_t all_shape_types = (1u << (TopAbs_SHAPE + 1)) - 1;
+
+} // namespace details
+
 // this wrapper class is here to make swig happy and because we dont understand how to wrap std::function directly.
+//
+// Internally, a ShapePredicate is an expression tree, that is simplified when combining
+// predicates with the operators &&, || and !, and compiled into a flat list of
+// instructions. Cheap checks like is_type and has_tag are evaluated first, hence the
+// wrapped functions should not have side effects. The wrapped functions are evaluated
+// in the order they have been combined, such that a function can guard the next one.
 class ShapePredicate
 {
 public:
-    inline ShapePredicate(std::function<bool(Shape const&)> const& f) : fun(f) {}
+    GEOML_API_EXPORT ShapePredicate(std::function<bool(Shape const&)> const& f);
 
     inline bool operator()(Shape const& s) const {
-        return fun(s);
+        return evaluate(s);
     }
 
     inline operator std::function<bool(Shape const&)>() {
-        return fun;
+        ShapePredicate pred = *this;
+        return [pred](Shape const& s) { return pred(s); };
     }
 
+#ifndef SWIG
+    GEOML_API_EXPORT explicit ShapePredicate(std::shared_ptr<const details::PredicateExpression> expression);
+
+    /**
+     * @brief returns the expression tree of this predicate
+     */
+    std::shared_ptr<const details::PredicateExpression> const& expression() const {
+        return m_expression;
+    }
+
+    /**
+     * @brief returns a bit mask of all shape types (1 << TopAbs_ShapeEnum), for which
+     * the predicate might be true. All other types are known to fail the predicate.
+     */
+    GEOML_API_EXPORT std::uint32_t type_mask() const;
+#endif
+
 private:
-    std::function<bool(Shape const&)> fun;
+    GEOML_API_EXPORT bool evaluate(Shape const& s) const;
+
+    std::shared_ptr<const details::PredicateExpression> m_expression;
 };
 
+/**
+ * @brief The id of an interned tag string, see intern_tag()
+ */
+using TagId = std::uint32_t;
+
+/**
+ * @brief returns the id of a tag string. All tags are interned in a
+ * global table, such that shapes store and compare integer ids instead
+ * of strings. The same string always results in the same id.
+ *
+ * @param tag a string metadata tag
+ */
+GEOML_API_EXPORT TagId intern_tag(std::string const& tag);
+
 /**
 * @brief A TagTrack stores
 *  - a tag name
@@ -88,6 +149,7 @@ class FindIfVisitor;
  */
 struct ShapeHasher {
 GEOML_API_EXPORT std::size_t operator()(Shape const& s) const;
+GEOML_API_EXPORT std::size_t operator()(TopoDS_Shape const& s) const;
 };
 
 /**
@@ -101,10 +163,36 @@ GEOML_API_EXPORT std::size_t operator()(Shape const& s) const;
  */
 struct ShapeIsSame {
 GEOML_API_EXPORT bool operator()(Shape const& l, Shape const& r) const;
+GEOML_API_EXPORT bool operator()(TopoDS_Shape const& l, TopoDS_Shape const& r) const;
 };
 
 using ShapeContainer = std::unordered_set<Shape, ShapeHasher, ShapeIsSame>;
 
+/**
+ * @brief A hash map with TopoDS_Shape keys. Two keys are considered 
+ * as equal, if TopoDS_Shape::IsSame returns true. 
+ *
+ * It can be used to look up shapes in O(1) without wrapping them 
+ * into a Shape first.
+ */
+template <typename T>
+using ShapeMap = std::unordered_map<TopoDS_Shape, T, ShapeHasher, ShapeIsSame>;
+
+/**
+ * @brief returns a bit mask of the shape types, that might satisfy the predicate.
+ * Only a ShapePredicate knows its types, see ShapePredicate::type_mask()
+ */
+template <typename Pred>
+std::uint32_t type_mask(Pred const&)
+{
+    return all_shape_types;
+}
+
+inline std::uint32_t type_mask(ShapePredicate const& pred)
+{
+    return pred.type_mask();
+}
+
 } // namespace details
 
 
@@ -167,11 +255,23 @@ public:
 
     /**
      * @brief returns the direct topological subshapes of the shape
+     *
+     * Modifying the children via the returned reference is not tracked by the
+     * subshape indices, use set_direct_subshapes() to modify the topology.
      * 
      * @return std::vector<Shape> the direct topological subshapes of the shape
      */
     GEOML_API_EXPORT std::vector<Shape>& direct_subshapes();
 
+    /**
+     * @brief replaces the direct topological subshapes of the shape. The
+     * subshape indices of all shapes containing this shape are rebuilt on
+     * their next query.
+     *
+     * @param children the new direct topological subshapes
+     */
+    GEOML_API_EXPORT void set_direct_subshapes(std::vector<Shape> children);
+
     /**
      * @brief returns all subshapes of the shape. 
      *
@@ -182,6 +282,18 @@ public:
      */
     GEOML_API_EXPORT Shape get_subshapes() const;
 
+    /**
+     * @brief returns all subshapes of the given type, e.g. all faces of a solid.
+     *
+     * This includes the shape itself, if it is of the given type. The subshapes
+     * are looked up in an index, which is built on the first query and reused
+     * until the topology is modified.
+     *
+     * @param shape_type the type of the subshapes
+     * @return Shape a collection of all subshapes of the given type
+     */
+    GEOML_API_EXPORT Shape get_subshapes_of_type(TopAbs_ShapeEnum shape_type) const;
+
 
     /**
      * @brief select_subshapes returns all subshapes, that satisfy a 
@@ -196,30 +308,24 @@ public:
      *                  satisfying the given predicate. Defaults to the maximum
      *                  integer
      * @return Shape A Shape wrapping a topological unconnected TopoDS_Compound of subshapes
-     *               satisfying the given predicate
+     *               satisfying the given predicate. Each subshape is contained once, in the
+     *               depth first order of its first occurrence within max_depth, i.e. in the
+     *               order of accept_topology_visitor.
      */
     template <typename Pred>
     Shape select_subshapes(Pred&& f, int max_depth = std::numeric_limits<int>::max()) const
     {
-        auto v = details::FindVisitor<Pred>(std::forward<Pred>(f), max_depth);
-        accept_topology_visitor(v);
-
-        TopoDS_Compound compound;
-        BRep_Builder builder;
-        builder.MakeCompound(compound);
-        for (auto const& s : v.results) {
-            builder.Add(compound, s);
+        // deep searches use the subshape index instead of walking the topology tree
+        if (max_depth > 1) {
+            return select_indexed_subshapes(f, max_depth);
         }
-        Shape result{compound};
 
-        // In the Shape constructor, new Shape instances are added as children
-        // from the TopoDS_Shape instances stored in the compound. These do not 
-        // yet have any historical data associated to them. To retain the historical
-        // modeling connections, we have to overwrite the children vector with the 
-        // result shapes from the visitor.
-        result.m_data->children = std::vector<Shape>(v.results.begin(), v.results.end());
+        auto v = details::FindVisitor<Pred>(std::forward<Pred>(f), max_depth);
+        accept_topology_visitor(v);
 
-        return result;
+        // The result shapes from the visitor are used as children of the result, 
+        // to retain their historical modeling connections.
+        return make_compound(std::move(v.ordered_results));
     }
 
     /**
@@ -288,6 +394,15 @@ public:
      */
     GEOML_API_EXPORT void add_meta_tag(std::string const& tag); // a meta_tag gets added to this shape (not to its subshapes)
 
+#ifndef SWIG
+    /**
+     * @brief adds an interned tag to this shape, see intern_tag()
+     *
+     * @param tag the id of a string metadata tag
+     */
+    GEOML_API_EXPORT void add_meta_tag(TagId tag);
+#endif
+
     /**
      * @brief adds a TagTrack to this shape. A tagtrack is useful to 
      * preserve metadata tags even after geometry modifications. See
@@ -336,7 +451,7 @@ public:
     {
         bool stop = v.visit(*this, depth);
         if (!stop && depth < v.max_depth()) {
-            for(auto const& origin : m_data->origins) {
+            for(auto const& origin : m_data->attributes->origins) {
                 if(origin.accept_history_visitor(v, depth+1)) {
                     return true;
                 }
@@ -365,7 +480,7 @@ public:
     {
         bool stop = v.visit(*this, depth);
         if (!stop && depth < v.max_depth()) {
-            for(auto const& child : m_data->children) {
+            for(auto const& child : m_data->get_children()) {
                 if (child.accept_topology_visitor(v, depth+1)) {
                     return true;
                 }
@@ -384,6 +499,9 @@ public:
 
     /**
      * @brief returns an iterator for the vector of direct topological children.
+     *
+     * Modifying the children via the iterator is not tracked by the subshape
+     * indices, see set_direct_subshapes().
      */
     GEOML_API_EXPORT iterator begin();
     
@@ -394,6 +512,9 @@ public:
     
     /**
      * @brief returns the past-the-end iterator for the vector of direct topological children. the 
+     *
+     * Modifying the children via the iterator is not tracked by the subshape
+     * indices, see set_direct_subshapes().
      */
     GEOML_API_EXPORT iterator const end();
     
@@ -406,6 +527,9 @@ public:
     
     /**
      * @brief retrieve the i-th direct topological child - (indexation starting from 0)
+     *
+     * Modifying the child via the returned reference is not tracked by the
+     * subshape indices, see set_direct_subshapes().
      * 
      * @param i the index of the topological child
      */
@@ -445,6 +569,11 @@ public:
      */
     GEOML_API_EXPORT bool is_type(TopAbs_ShapeEnum shape_type) const;
 
+    /**
+     * @brief returns the type of the wrapped TopoDS_Shape
+     */
+    GEOML_API_EXPORT TopAbs_ShapeEnum shape_type() const;
+
     /**
      * @brief returns true, if this shape is the same as the other. 
      * This is true, if the wrapped shapes A and B satisfy A.IsSame(B).
@@ -553,11 +682,25 @@ public:
     
     /**
      * @brief returns true, if this shape has the given tag
+     *
+     * The tag is looked up in the global tag table on each call. When checking
+     * many shapes, prefer the has_tag predicate or has_tag(TagId), which
+     * intern the tag only once.
      * 
      * @param tag a tag is a string metadata
      */
     GEOML_API_EXPORT bool has_tag(std::string const& tag) const;
 
+#ifndef SWIG
+    /**
+     * @brief returns true, if this shape has the given interned tag.
+     * This is a binary search in the sorted tag ids of the shape, see intern_tag()
+     *
+     * @param tag the id of a string metadata tag
+     */
+    GEOML_API_EXPORT bool has_tag(TagId tag) const;
+#endif
+
     /**
      * @brief returns true if this shape has a subshape that 
      * satisfies the given predicate. This includes the shape itself
@@ -576,33 +719,264 @@ public:
 
 private:
 
+    /**
+     * @brief The SubshapeIndex stores all subshapes of a shape by type and
+     * by TopoDS_Shape identity, see subshape_index()
+     */
+    struct SubshapeIndex;
+
+    /**
+     * @brief returns the index of all subshapes. It is built on first access and
+     * rebuilt, if the topology of any of the subshapes has been modified in the meantime.
+     */
+    GEOML_API_EXPORT std::shared_ptr<const SubshapeIndex> subshape_index() const;
+
+    /**
+     * @brief returns a compound of the shapes, that uses the shapes as
+     * children to retain their history and tags.
+     */
+    GEOML_API_EXPORT static Shape make_compound(std::vector<Shape>&& shapes);
+
+    template <typename Pred>
+    Shape select_indexed_subshapes(Pred& f, int max_depth) const;
+
+    struct Data;
+
+    /**
+     * @brief The SubshapeTable interns the subshapes of a root shape, such that
+     * each distinct subshape is represented by a single Data node, see make_children()
+     */
+    struct SubshapeTable;
+
+    /**
+     * @brief returns the subshape table of the topology tree of the shape wrapped
+     * by data. A new table is created, if the shape is the root of a topology tree.
+     */
+    static std::shared_ptr<SubshapeTable> subshape_table_of(Data& data);
+
+    /**
+     * @brief marks the subshape indices of all shapes, that contain the shape
+     * wrapped by data, as outdated
+     */
+    GEOML_API_EXPORT static void invalidate_subshape_indices(Data& data);
+
+    /**
+     * @brief returns the direct topology children of the shape wrapped by data.
+     * Children, that occur more than once in the topology tree of the same root
+     * shape (e.g. an edge shared by two faces), share their Data node. Subshapes
+     * are distinct, if they differ in TShape, location or orientation.
+     */
+    GEOML_API_EXPORT static std::vector<Shape> make_children(Data& data);
+
+    /**
+     * @brief wraps an existing data node
+     */
+    explicit Shape(std::shared_ptr<Data> data);
+
+    /**
+     * @brief The HistoryCache of a shape stores the history distances of
+     * other shapes to this shape, see is_descendent_of()
+     */
+    struct HistoryCache;
+
+    /**
+     * @brief marks the history caches of all shapes as outdated
+     */
+    GEOML_API_EXPORT static void invalidate_history_caches();
+
+    /**
+     * @brief returns a unique id for a new shape node
+     */
+    GEOML_API_EXPORT static std::uint64_t next_node_id();
+
+    /**
+     * @brief calls f for all historical ancestors of this shape up to max_depth
+     * in breadth first order, including this shape. Each ancestor is visited only
+     * once. The search stops, if f returns true.
+     *
+     * @return true, if f returned true for any ancestor
+     */
+    GEOML_API_EXPORT bool visit_ancestors(int max_depth, std::function<bool(Shape const&)> const& f) const;
+
     /**
      * @brief The data of a Shape is stored in a shared_ptr to make sure
      * it is a lightweight wrapper around shared memory
      */
     struct Data {
 
-        inline explicit Data(TopoDS_Shape const& theShape)
+        /**
+         * @brief The history and tags of a shape. They are shared by all
+         * nodes of a topology tree, that wrap the same subshape (w.r.t.
+         * is_same) in different orientations, e.g. an edge shared by two faces.
+         */
+        struct Attributes {
+            std::vector<Shape> origins;  /** direct history parents, use Data::add_origin() to add one */
+            std::vector<TagId> persistent_meta_tags; /** the ids of all persistent metatags in ascending order, see intern_tag() */
+            std::vector<TagTrack> tag_tracks; /** the associated tag tracks of a shape */
+        };
+
+        inline explicit Data(TopoDS_Shape const& theShape,
+                             std::shared_ptr<Attributes> theAttributes = std::make_shared<Attributes>())
         : shape(theShape)
+        , id(Shape::next_node_id())
+        , attributes(std::move(theAttributes))
+        {}
+
+        /**
+         * @brief adds a direct history parent
+         */
+        inline void add_origin(Shape const& origin)
+        {
+            attributes->origins.push_back(origin);
+            Shape::invalidate_history_caches();
+        }
+
+        /**
+         * @brief returns the direct topology children. They are
+         * created from the wrapped TopoDS_Shape on first access only,
+         * such that wrapping a large shape does not allocate its
+         * whole topology tree up front.
+         */
+        inline std::vector<Shape>& get_children()
         {
-            for (TopoDS_Iterator it(shape); it.More(); it.Next()) {
-                    children.push_back(Shape(it.Value()));
+            if (!children_materialized.load(std::memory_order_acquire)) {
+                std::lock_guard<std::mutex> guard(children_mutex);
+                if (!children_materialized.load(std::memory_order_relaxed)) {
+                    children = Shape::make_children(*this);
+                    children_materialized.store(true, std::memory_order_release);
+                }
             }
+            return children;
+        }
+
+        /**
+         * @brief replaces the direct topology children, e.g. to retain
+         * existing history and tag data of the children
+         */
+        inline void set_children(std::vector<Shape>&& new_children)
+        {
+            init_children(std::move(new_children));
+            Shape::invalidate_subshape_indices(*this);
+        }
+
+        /**
+         * @brief sets the direct topology children of a new shape, that
+         * is not yet a subshape of any other shape
+         */
+        inline void init_children(std::vector<Shape>&& new_children)
+        {
+            std::lock_guard<std::mutex> guard(children_mutex);
+            children = std::move(new_children);
+            children_materialized.store(true, std::memory_order_release);
         }
 
         TopoDS_Shape shape; /** the wrapped TopoDS_Shape */
 
-        std::vector<Shape> children; /** direct topology children */
-        std::vector<Shape> origins;  /** direct history parents */
+        const std::uint64_t id; /** unique id of this node in the topology and history graphs */
+
+        const std::shared_ptr<Attributes> attributes; /** history and tags, shared by all orientations of the shape */
+
+        std::shared_ptr<const SubshapeIndex> subshape_index; /** the subshape index, use Shape::subshape_index() */
+        std::mutex subshape_index_mutex; /** guards the creation of the subshape index */
+
+        std::shared_ptr<SubshapeTable> subshape_table; /** the subshapes of the root shape, shared by the root and all its subshapes, use Shape::subshape_table_of() */
+        std::mutex subshape_table_mutex; /** guards the creation of the subshape table */
 
-        std::vector<std::string> persistent_meta_tags; /** all persistent metatags */
-        std::vector<TagTrack> tag_tracks; /** the associated tag tracks of a shape */
+        std::shared_ptr<HistoryCache> history_cache; /** the history distances to this shape, see Shape::is_descendent_of() */
+        std::mutex history_cache_mutex; /** guards the history cache */
+
+    private:
+        std::vector<Shape> children; /** direct topology children, use get_children() */
+        std::atomic<bool> children_materialized {false}; /** true, if children have been created */
+        std::mutex children_mutex; /** guards the creation of the children */
     };
 
     std::shared_ptr<Data> m_data; /** The data associated with this shape */
 
 };
 
+#ifndef SWIG
+
+struct Shape::SubshapeIndex
+{
+    /**
+     * @brief returns the node with the given index. The first node is the
+     * indexed shape itself, which is not stored to avoid a reference cycle.
+     */
+    Shape const& node(Shape const& root, size_t inode) const
+    {
+        return inode == 0 ? root : nodes[inode];
+    }
+
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    std::vector<Shape> nodes;     /** all subshapes in the order of accept_topology_visitor, shared subshapes occur once per parent */
+    std::vector<int> depths;      /** the depth of each node in the topology tree */
+    std::vector<size_t> ids;      /** the id of the distinct subshape (w.r.t. is_same) of each node */
+    std::vector<size_t> first;    /** the first node of each distinct subshape, indexed by id */
+    std::vector<size_t> next;     /** the next node of the same distinct subshape of each node, or npos */
+    std::vector<std::vector<size_t>> ids_by_type; /** the ids of the distinct subshapes of each type */
+    int height = 0;               /** the maximum depth of all nodes */
+    details::ShapeMap<size_t> ids_by_shape;       /** the ids of the distinct subshapes */
+    std::vector<std::pair<std::shared_ptr<SubshapeTable>, std::uint64_t>> versions; /** the versions of the subshape tables of all nodes, the index has been built for */
+};
+
+template <typename Pred>
+Shape Shape::select_indexed_subshapes(Pred& f, int max_depth) const
+{
+    std::shared_ptr<const SubshapeIndex> index = subshape_index();
+
+    // If the predicate is known to fail for some shape types, only the subshapes
+    // of the remaining types are checked. The ids are in the order of the first
+    // occurrence of each subshape, which is the order of the selection below.
+    std::uint32_t types = details::type_mask(f);
+    if (types != details::all_shape_types && max_depth >= index->height) {
+        std::vector<size_t> ids;
+        int ntypes = 0;
+        for (int type = 0; type <= TopAbs_SHAPE; ++type) {
+            if ((types >> type) & 1u) {
+                auto const& type_ids = index->ids_by_type[type];
+                ids.insert(ids.end(), type_ids.begin(), type_ids.end());
+                ++ntypes;
+            }
+        }
+        if (ntypes > 1) {
+            std::sort(ids.begin(), ids.end());
+        }
+
+        // the predicate might depend on the orientation of the subshape, hence
+        // each occurrence is checked until the first one satisfies it
+        std::vector<Shape> results;
+        for (size_t id : ids) {
+            for (size_t inode = index->first[id]; inode != SubshapeIndex::npos; inode = index->next[inode]) {
+                Shape const& node = index->node(*this, inode);
+                if (f(node)) {
+                    results.push_back(node);
+                    break;
+                }
+            }
+        }
+        return make_compound(std::move(results));
+    }
+
+    // each distinct subshape is selected at most once
+    std::vector<char> selected(index->first.size(), 0);
+    std::vector<Shape> results;
+    for (size_t inode = 0; inode < index->nodes.size(); ++inode) {
+        size_t id = index->ids[inode];
+        if (!selected[id] && index->depths[inode] <= max_depth) {
+            Shape const& node = index->node(*this, inode);
+            if (f(node)) {
+                selected[id] = 1;
+                results.push_back(node);
+            }
+        }
+    }
+    return make_compound(std::move(results));
+}
+
+#endif
+
 namespace details {
 
 /**
@@ -680,8 +1054,8 @@ public:
      * @return false always
      */
     bool visit(Shape const& shape, int depth) {
-        if (depth <= max_depth() && m_f(shape)) {
-            results.insert(shape);
+        if (depth <= max_depth() && m_f(shape) && results.insert(shape).second) {
+            ordered_results.push_back(shape);
         }
         return false;
     }
@@ -696,6 +1070,7 @@ public:
     }
 
     ShapeContainer results; /** the retained shapes satisfying the predicates */
+    std::vector<Shape> ordered_results; /** the retained shapes in the order of their first visit */
 
 private:
     Pred m_f; /** the predicate function */
@@ -2,29 +2,273 @@
 
 namespace geoml{
 
+namespace details {
+
+struct PredicateExpression
+{
+    enum Kind {
+        TYPE,     /** the shape type is in types */
+        TAG,      /** the shape has the tag */
+        FUNCTION, /** an arbitrary function */
+        AND,      /** all children are true */
+        OR,       /** any child is true */
+        NOT       /** the single child is false */
+    };
+
+    /**
+     * @brief A single instruction of the compiled expression. The instructions
+     * operate on a single boolean register, jumps implement the short circuit
+     * evaluation of AND and OR.
+     */
+    struct Instruction {
+        enum Op {
+            CHECK_TYPE,
+            CHECK_TAG,
+            CALL,
+            NEGATE,
+            JUMP_IF_FALSE,
+            JUMP_IF_TRUE
+        };
+
+        Op op;
+        std::uint32_t arg; /** the type mask, the tag or the jump target */
+        PredicateExpression const* node; /** the node of CALL */
+    };
+
+    Kind kind = FUNCTION;
+    std::uint32_t types = 0;
+    TagId tag = 0;
+    std::function<bool(Shape const&)> function;
+    std::vector<std::shared_ptr<const PredicateExpression>> children;
+
+    std::uint32_t possible_types = all_shape_types; /** the types, that might satisfy the expression */
+    std::vector<Instruction> program; /** the compiled expression */
+};
+
+namespace {
+
+using PExpression = std::shared_ptr<const PredicateExpression>;
+
+void compile(PredicateExpression const& node, std::vector<PredicateExpression::Instruction>& program)
+{
+    using Instruction = PredicateExpression::Instruction;
+
+    switch (node.kind) {
+    case PredicateExpression::TYPE:
+        program.push_back({Instruction::CHECK_TYPE, node.types, nullptr});
+        break;
+    case PredicateExpression::TAG:
+        program.push_back({Instruction::CHECK_TAG, node.tag, nullptr});
+        break;
+    case PredicateExpression::FUNCTION:
+        program.push_back({Instruction::CALL, 0, &node});
+        break;
+    case PredicateExpression::NOT:
+        compile(*node.children.front(), program);
+        program.push_back({Instruction::NEGATE, 0, nullptr});
+        break;
+    case PredicateExpression::AND:
+    case PredicateExpression::OR: {
+        // after each child but the last one, jump to the end if the result is known
+        auto op = node.kind == PredicateExpression::AND ? Instruction::JUMP_IF_FALSE : Instruction::JUMP_IF_TRUE;
+        std::vector<size_t> jumps;
+        for (size_t i = 0; i < node.children.size(); ++i) {
+            compile(*node.children[i], program);
+            if (i + 1 < node.children.size()) {
+                jumps.push_back(program.size());
+                program.push_back({op, 0, nullptr});
+            }
+        }
+        for (size_t jump : jumps) {
+            program[jump].arg = static_cast<std::uint32_t>(program.size());
+        }
+        break;
+    }
+    }
+}
+
+// computes the derived data of a new node and compiles it
+PExpression finish(std::shared_ptr<PredicateExpression> node)
+{
+    switch (node->kind) {
+    case PredicateExpression::TYPE:
+        node->possible_types = node->types;
+        break;
+    case PredicateExpression::TAG:
+    case PredicateExpression::FUNCTION:
+    case PredicateExpression::NOT:
+        break;
+    case PredicateExpression::AND:
+        for (auto const& child : node->children) {
+            node->possible_types &= child->possible_types;
+        }
+        break;
+    case PredicateExpression::OR:
+        node->possible_types = 0;
+        for (auto const& child : node->children) {
+            node->possible_types |= child->possible_types;
+        }
+        break;
+    }
+
+    compile(*node, node->program);
+    return node;
+}
+
+PExpression make_type(std::uint32_t types)
+{
+    auto node = std::make_shared<PredicateExpression>();
+    node->kind = PredicateExpression::TYPE;
+    node->types = types;
+    return finish(node);
+}
+
+// combines the expressions to an AND or OR expression. Nested expressions
+// of the same kind are flattened and type checks are merged into a single one.
+// The type and tag checks are evaluated first, as they are cheap and cannot fail.
+// All other operands retain their relative order, as an operand might be a guard
+// for the preconditions of the following ones.
+PExpression make_junction(PredicateExpression::Kind kind, PExpression const& l, PExpression const& r)
+{
+    bool is_and = kind == PredicateExpression::AND;
+
+    std::vector<PExpression> tags;
+    std::vector<PExpression> others;
+    bool has_types = false;
+    std::uint32_t types = is_and ? all_shape_types : 0;
+    for (auto const& expression : {l, r}) {
+        auto const& operands = expression->kind == kind ? expression->children : std::vector<PExpression>{expression};
+        for (auto const& operand : operands) {
+            if (operand->kind == PredicateExpression::TYPE) {
+                types = is_and ? (types & operand->types) : (types | operand->types);
+                has_types = true;
+            }
+            else if (operand->kind == PredicateExpression::TAG) {
+                tags.push_back(operand);
+            }
+            else {
+                others.push_back(operand);
+            }
+        }
+    }
+
+    std::vector<PExpression> children;
+    if (has_types) {
+        children.push_back(make_type(types));
+    }
+    children.insert(children.end(), tags.begin(), tags.end());
+    children.insert(children.end(), others.begin(), others.end());
+
+    if (children.size() == 1) {
+        return children.front();
+    }
+
+    auto node = std::make_shared<PredicateExpression>();
+    node->kind = kind;
+    node->children = std::move(children);
+    return finish(node);
+}
+
+PExpression make_not(PExpression const& expression)
+{
+    if (expression->kind == PredicateExpression::NOT) {
+        return expression->children.front();
+    }
+    if (expression->kind == PredicateExpression::TYPE) {
+        return make_type(all_shape_types & ~expression->types);
+    }
+
+    auto node = std::make_shared<PredicateExpression>();
+    node->kind = PredicateExpression::NOT;
+    node->children.push_back(expression);
+    return finish(node);
+}
+
+} // namespace
+
+} // namespace details
+
+ShapePredicate::ShapePredicate(std::function<bool(Shape const&)> const& f)
+{
+    auto node = std::make_shared<details::PredicateExpression>();
+    node->kind = details::PredicateExpression::FUNCTION;
+    node->function = f;
+    m_expression = details::finish(node);
+}
+
+ShapePredicate::ShapePredicate(std::shared_ptr<const details::PredicateExpression> expression)
+    : m_expression(std::move(expression))
+{}
+
+std::uint32_t ShapePredicate::type_mask() const
+{
+    return m_expression->possible_types;
+}
+
+bool ShapePredicate::evaluate(Shape const& s) const
+{
+    using Instruction = details::PredicateExpression::Instruction;
+
+    auto const& program = m_expression->program;
+    bool result = false;
+    size_t pc = 0;
+    while (pc < program.size()) {
+        Instruction const& instruction = program[pc++];
+        switch (instruction.op) {
+        case Instruction::CHECK_TYPE:
+            result = (instruction.arg >> s.shape_type()) & 1u;
+            break;
+        case Instruction::CHECK_TAG:
+            result = s.has_tag(static_cast<TagId>(instruction.arg));
+            break;
+        case Instruction::CALL:
+            result = instruction.node->function(s);
+            break;
+        case Instruction::NEGATE:
+            result = !result;
+            break;
+        case Instruction::JUMP_IF_FALSE:
+            if (!result) {
+                pc = instruction.arg;
+            }
+            break;
+        case Instruction::JUMP_IF_TRUE:
+            if (result) {
+                pc = instruction.arg;
+            }
+            break;
+        }
+    }
+    return result;
+}
+
 ShapePredicate operator&&(ShapePredicate const& l, ShapePredicate const& r)
 {
-    return ShapePredicate([=](Shape const& s){ return l(s) && r(s); });
+    return ShapePredicate(details::make_junction(details::PredicateExpression::AND, l.expression(), r.expression()));
 }
 
 ShapePredicate operator||(ShapePredicate const& l, ShapePredicate const& r)
 {
-    return ShapePredicate([=](Shape const& s){ return l(s) || r(s); });
+    return ShapePredicate(details::make_junction(details::PredicateExpression::OR, l.expression(), r.expression()));
 }
 
 ShapePredicate operator!(ShapePredicate const& pred)
 {
-    return ShapePredicate([=](Shape const& s){ return !pred(s); });
+    return ShapePredicate(details::make_not(pred.expression()));
 }
 
 ShapePredicate has_tag(std::string const& tag)
 {
-    return ShapePredicate([=](Shape const& s){ return s.has_tag(tag); });
+    // compare the interned id instead of the string for each shape
+    auto node = std::make_shared<details::PredicateExpression>();
+    node->kind = details::PredicateExpression::TAG;
+    node->tag = intern_tag(tag);
+    return ShapePredicate(details::finish(node));
 }
 
 ShapePredicate is_type(TopAbs_ShapeEnum shape_type)
 {
-    return ShapePredicate([=](Shape const& s){ return s.is_type(shape_type); });
+    return ShapePredicate(details::make_type(1u << shape_type));
 }
 
 ShapePredicate is_same(Shape const& other)
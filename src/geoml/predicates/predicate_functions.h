@@ -31,26 +31,29 @@ GEOML_API_EXPORT ShapePredicate operator||(ShapePredicate const& l, ShapePredica
 
 GEOML_API_EXPORT ShapePredicate operator!(ShapePredicate const& pred);
 
+/**
+ * @brief Returns the ShapePredicate checking the type of a shape. Type checks are
+ * evaluated before other checks and allow select_subshapes to skip all subshapes
+ * of other types.
+ *
+ * @param shape_type the type of the shape
+ */
+GEOML_API_EXPORT ShapePredicate is_type(TopAbs_ShapeEnum shape_type);
 
 // This is necessary, because SWIG had difficulty parsing the inline definitions with lambda functions
 // directly
 namespace details {
-    inline bool _is_vertex(Shape const& s){ return s.is_type(TopAbs_VERTEX); }
-    inline bool _is_edge(Shape const& s){ return s.is_type(TopAbs_EDGE); }
-    inline bool _is_face(Shape const& s){ return s.is_type(TopAbs_FACE); }
-    inline bool _is_solid(Shape const& s){ return s.is_type(TopAbs_SOLID); }
     inline bool _has_origin(Shape const& s){ return s.has_origin(); }
 }
 
-inline ShapePredicate const is_vertex = ShapePredicate(&details::_is_vertex);
-inline ShapePredicate const is_edge = ShapePredicate(&details::_is_edge);
-inline ShapePredicate const is_face = ShapePredicate(&details::_is_face);
-inline ShapePredicate const is_solid = ShapePredicate(&details::_is_solid);
+inline ShapePredicate const is_vertex = is_type(TopAbs_VERTEX);
+inline ShapePredicate const is_edge = is_type(TopAbs_EDGE);
+inline ShapePredicate const is_face = is_type(TopAbs_FACE);
+inline ShapePredicate const is_solid = is_type(TopAbs_SOLID);
 inline ShapePredicate const has_origin = ShapePredicate(&details::_has_origin);
 
 // some free functions returning shape predicates
 GEOML_API_EXPORT ShapePredicate has_tag(std::string const& tag);
-GEOML_API_EXPORT ShapePredicate is_type(TopAbs_ShapeEnum shape_type);
 GEOML_API_EXPORT ShapePredicate is_same(Shape const& other);
 GEOML_API_EXPORT ShapePredicate is_same(TopoDS_Shape const& other); 
 GEOML_API_EXPORT ShapePredicate has_subshape(Shape const& shape);
@@ -0,0 +1,39 @@
+#pragma once
+
+/**
+ * @brief geoml/surfaces/SurfaceGridValues.h defines the result of a grid evaluation of a surface
+ */
+
+#include <vector>
+
+namespace geoml
+{
+
+/**
+ * @brief Surface points (and optionally derivatives and normals) on a (u,v) parameter grid
+ *
+ * The data is stored as a structure of arrays. The values at the parameters (u[i], v[j])
+ * are stored at the index i * nv + j of each array. The arrays of the derivatives and
+ * normals are empty, if they were not requested.
+ */
+struct SurfaceGridValues
+{
+    /// Number of u parameters
+    int nu = 0;
+    /// Number of v parameters
+    int nv = 0;
+
+    /// Surface points
+    std::vector<double> x, y, z;
+
+    /// First derivatives in u direction
+    std::vector<double> du_x, du_y, du_z;
+
+    /// First derivatives in v direction
+    std::vector<double> dv_x, dv_y, dv_z;
+
+    /// Unit normals, zero where the surface is degenerated
+    std::vector<double> normal_x, normal_y, normal_z;
+};
+
+} // namespace geoml
@@ -4,6 +4,9 @@
 
 #include "geometry/curve-networks/InterpolateCurveNetwork.h"
 #include "geometry/CurvesToSurface.h"
+#include "geometry/BSplineEvaluator.h"
+#include "geometry/SurfaceCache.h"
+#include "geoml/error.h"
 #include "common/CommonFunctions.h"
 
 #include "BRepBuilderAPI_MakeEdge.hxx"
@@ -33,18 +36,42 @@ Handle(Geom_BSplineSurface) interpolate_curve_network(const std::vector<Handle (
                                  const std::vector<Handle (Geom_Curve)> &vcurves,
                                  double tolerance)
 {
-    InterpolateCurveNetwork interpolator(ucurves, vcurves, tolerance);
+    SurfaceCacheKey key("interpolate_curve_network");
+    key.Add(ucurves).Add(vcurves).Add(tolerance);
 
-    return interpolator.Surface();
+    return SurfaceCache::Instance().GetOrCompute(key, [&]() {
+        InterpolateCurveNetwork interpolator(ucurves, vcurves, tolerance);
+        return interpolator.Surface();
+    });
 }
 
 Handle(Geom_BSplineSurface)
 interpolate_curves(const std::vector<Handle (Geom_Curve)> &ucurves, unsigned int max_degree,
                           bool join_continuously)
 {
-    CurvesToSurface c2s(ucurves, join_continuously);
-    c2s.SetMaxDegree(max_degree);
-    return c2s.Surface();
+    SurfaceCacheKey key("interpolate_curves");
+    key.Add(ucurves).Add(max_degree).Add(join_continuously);
+
+    return SurfaceCache::Instance().GetOrCompute(key, [&]() {
+        CurvesToSurface c2s(ucurves, join_continuously);
+        c2s.SetMaxDegree(static_cast<int>(max_degree));
+        return c2s.Surface();
+    });
+}
+
+void enable_surface_cache(size_t max_entries, const std::string& directory)
+{
+    SurfaceCache::Instance().Enable(max_entries, directory);
+}
+
+void disable_surface_cache()
+{
+    SurfaceCache::Instance().Disable();
+}
+
+void clear_surface_cache()
+{
+    SurfaceCache::Instance().Clear();
 }
 
 TopoDS_Shape
@@ -105,4 +132,16 @@ create_face(const gp_Pnt &p_1, const gp_Pnt &p_2, const gp_Pnt &p_3, const gp_Pn
     return face;
 }
 
+SurfaceGridValues
+evaluate_surface_grid(const Handle(Geom_BSplineSurface)& surface, const std::vector<double>& u,
+                      const std::vector<double>& v, bool derivatives, bool normals)
+{
+    if (surface.IsNull()) {
+        throw geoml::Error("Null pointer surface in evaluate_surface_grid", geoml::NULL_POINTER);
+    }
+
+    BSplineSurfaceEvaluator evaluator(surface);
+    return evaluator.EvaluateGrid(u, v, derivatives, normals);
+}
+
 } // namespace geoml
@@ -8,6 +8,7 @@
 #include <geoml/geoml.h>
 
 #include "geoml/data_structures/Array2d.h"
+#include "geoml/surfaces/SurfaceGridValues.h"
 
 #include <Geom_BSplineSurface.hxx>
 #include <Geom_Curve.hxx>
@@ -16,6 +17,7 @@
 #include <TopoDS_Shape.hxx>
 #include <TopoDS_Face.hxx>
 
+#include <string>
 #include <vector>
 #include <cmath>
 
@@ -54,6 +56,33 @@ interpolate_curves(const std::vector<Handle(Geom_Curve)>& curves,
                    unsigned int max_degree=3,
                    bool join_continuously=false);
 
+/**
+ * @brief Enables the cache of the surface interpolation functions
+ *
+ * If enabled, interpolate_curve_network and interpolate_curves return the
+ * stored result, if they were already called with the same input. The inputs
+ * are compared by their content (poles, knots, weights and parameters), not
+ * by their identity.
+ *
+ * @param max_entries Maximum number of surfaces kept in memory
+ * @param directory If not empty, the surfaces are additionally stored in this
+ *        directory. This allows to share the results between processes and restarts.
+ */
+GEOML_API_EXPORT void
+enable_surface_cache(size_t max_entries=100, const std::string& directory="");
+
+/**
+ * @brief Disables the cache of the surface interpolation functions
+ */
+GEOML_API_EXPORT void
+disable_surface_cache();
+
+/**
+ * @brief Removes all surfaces from the in-memory cache. Files on disk are kept.
+ */
+GEOML_API_EXPORT void
+clear_surface_cache();
+
 /**
  * @brief Create a revolving shape
  *
@@ -110,5 +139,22 @@ create_surface(const gp_Pnt &p_1, const gp_Pnt &p_2, const gp_Pnt &p_3, const gp
 GEOML_API_EXPORT TopoDS_Face
 create_face(const gp_Pnt &p_1, const gp_Pnt &p_2, const gp_Pnt &p_3, const gp_Pnt &p_4); 
 
+/**
+ * @brief Evaluates a B-spline surface on a tensor product grid of parameters
+ *
+ * This is much faster than evaluating each grid point separately, as the basis
+ * functions are computed only once per u and v parameter.
+ *
+ * @param surface     The surface to evaluate
+ * @param u           The u parameters of the grid
+ * @param v           The v parameters of the grid
+ * @param derivatives If true, the first derivatives in u and v direction are computed
+ * @param normals     If true, the unit normals are computed
+ * @return The values at (u[i], v[j]) are stored at the index i * v.size() + j
+ */
+GEOML_API_EXPORT SurfaceGridValues
+evaluate_surface_grid(const Handle(Geom_BSplineSurface)& surface, const std::vector<double>& u,
+                      const std::vector<double>& v, bool derivatives=false, bool normals=false);
+
 
 } // namespace geoml
@@ -0,0 +1,192 @@
+#include "BandedMatrix.h"
+
+#include "geoml/error.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+
+// validates the matrix size before any storage is allocated
+int checkedSize(int n)
+{
+    if (n < 1) {
+        throw geoml::Error("Invalid size of SymmetricBandedMatrix", geoml::MATH_ERROR);
+    }
+    return n;
+}
+
+} // namespace
+
+namespace geoml
+{
+
+SymmetricBandedMatrix::SymmetricBandedMatrix(int n, int bandwidth)
+    : m_n(checkedSize(n))
+    , m_bandwidth(std::max(0, std::min(bandwidth, n - 1)))
+    , m_factorized(false)
+    , m_data(static_cast<size_t>(n) * static_cast<size_t>(m_bandwidth + 1), 0.)
+{
+}
+
+int SymmetricBandedMatrix::Size() const
+{
+    return m_n;
+}
+
+int SymmetricBandedMatrix::Bandwidth() const
+{
+    return m_bandwidth;
+}
+
+double& SymmetricBandedMatrix::operator()(int i, int j)
+{
+    if (i < j || i - j > m_bandwidth || j < 1 || i > m_n) {
+        throw Error("Index out of band in SymmetricBandedMatrix", geoml::INDEX_ERROR);
+    }
+    return m_data[index(i, j)];
+}
+
+double SymmetricBandedMatrix::operator()(int i, int j) const
+{
+    if (i < j) {
+        std::swap(i, j);
+    }
+    if (i - j > m_bandwidth) {
+        return 0.;
+    }
+    return m_data[index(i, j)];
+}
+
+bool SymmetricBandedMatrix::Factorize(double relativePivotTolerance)
+{
+    double maxDiag = 0.;
+    for (int i = 1; i <= m_n; ++i) {
+        maxDiag = std::max(maxDiag, std::abs(m_data[index(i, i)]));
+    }
+    const double minPivot = relativePivotTolerance * maxDiag;
+
+    for (int i = 1; i <= m_n; ++i) {
+        const int kmin = std::max(1, i - m_bandwidth);
+        for (int j = kmin; j <= i; ++j) {
+            double sum = m_data[index(i, j)];
+            for (int k = kmin; k < j; ++k) {
+                sum -= m_data[index(i, k)] * m_data[index(j, k)];
+            }
+
+            if (i == j) {
+                if (sum <= minPivot) {
+                    m_factorized = false;
+                    return false;
+                }
+                m_data[index(i, i)] = std::sqrt(sum);
+            }
+            else {
+                m_data[index(i, j)] = sum / m_data[index(j, j)];
+            }
+        }
+    }
+
+    m_factorized = true;
+    return true;
+}
+
+bool SymmetricBandedMatrix::IsFactorized() const
+{
+    return m_factorized;
+}
+
+void SymmetricBandedMatrix::Solve(math_Vector& b) const
+{
+    if (!m_factorized) {
+        throw Error("SymmetricBandedMatrix is not factorized", geoml::MATH_ERROR);
+    }
+    if (b.Length() != m_n) {
+        throw Error("Dimension mismatch in SymmetricBandedMatrix::Solve", geoml::MATH_ERROR);
+    }
+
+    const int offset = b.Lower() - 1;
+
+    // forward substitution L*y = b
+    for (int i = 1; i <= m_n; ++i) {
+        double sum = b(i + offset);
+        for (int k = std::max(1, i - m_bandwidth); k < i; ++k) {
+            sum -= m_data[index(i, k)] * b(k + offset);
+        }
+        b(i + offset) = sum / m_data[index(i, i)];
+    }
+
+    // backward substitution L^T*x = y
+    for (int i = m_n; i >= 1; --i) {
+        double sum = b(i + offset);
+        for (int k = i + 1; k <= std::min(m_n, i + m_bandwidth); ++k) {
+            sum -= m_data[index(k, i)] * b(k + offset);
+        }
+        b(i + offset) = sum / m_data[index(i, i)];
+    }
+}
+
+void SymmetricBandedMatrix::Solve(math_Matrix& B) const
+{
+    if (!m_factorized) {
+        throw Error("SymmetricBandedMatrix is not factorized", geoml::MATH_ERROR);
+    }
+    if (B.RowNumber() != m_n) {
+        throw Error("Dimension mismatch in SymmetricBandedMatrix::Solve", geoml::MATH_ERROR);
+    }
+
+    // The rows of a math_Matrix are stored contiguously. Hence, all
+    // right hand sides are processed at once in the innermost loops.
+    const int nrhs = B.ColNumber();
+    const int offset = B.LowerRow() - 1;
+    auto row = [&B, offset](int i) {
+        return &B(i + offset, B.LowerCol());
+    };
+
+    // forward substitution L*Y = B
+    for (int i = 1; i <= m_n; ++i) {
+        double* bi = row(i);
+        for (int k = std::max(1, i - m_bandwidth); k < i; ++k) {
+            const double l = m_data[index(i, k)];
+            const double* bk = row(k);
+            for (int c = 0; c < nrhs; ++c) {
+                bi[c] -= l * bk[c];
+            }
+        }
+        const double invDiag = 1. / m_data[index(i, i)];
+        for (int c = 0; c < nrhs; ++c) {
+            bi[c] *= invDiag;
+        }
+    }
+
+    // backward substitution L^T*X = Y
+    for (int i = m_n; i >= 1; --i) {
+        double* bi = row(i);
+        for (int k = i + 1; k <= std::min(m_n, i + m_bandwidth); ++k) {
+            const double l = m_data[index(k, i)];
+            const double* bk = row(k);
+            for (int c = 0; c < nrhs; ++c) {
+                bi[c] -= l * bk[c];
+            }
+        }
+        const double invDiag = 1. / m_data[index(i, i)];
+        for (int c = 0; c < nrhs; ++c) {
+            bi[c] *= invDiag;
+        }
+    }
+}
+
+math_Matrix SymmetricBandedMatrix::ToDense() const
+{
+    math_Matrix result(1, m_n, 1, m_n, 0.);
+    for (int i = 1; i <= m_n; ++i) {
+        for (int j = std::max(1, i - m_bandwidth); j <= i; ++j) {
+            result(i, j) = m_data[index(i, j)];
+            result(j, i) = m_data[index(i, j)];
+        }
+    }
+    return result;
+}
+
+} // namespace geoml
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "geoml_internal.h"
+
+#include <math_Matrix.hxx>
+#include <math_Vector.hxx>
+
+#include <vector>
+
+namespace geoml
+{
+
+/**
+ * @brief A symmetric band matrix including a Cholesky solver
+ *
+ * Only the lower band, i.e. all entries A(i,j) with 0 <= i-j <= bandwidth,
+ * is stored. For a B-spline basis matrix A of degree p, the matrix
+ * A^T*A is a symmetric band matrix of bandwidth p. Its Cholesky decomposition
+ * requires O(n*p^2) operations and O(n*p) memory instead of O(n^3) and O(n^2)
+ * for a dense Gauss solver.
+ *
+ * As for math_Matrix, indices start at 1.
+ */
+class SymmetricBandedMatrix
+{
+public:
+    /**
+     * @brief Creates a zero initialized n x n matrix
+     * @param n Number of rows and columns
+     * @param bandwidth Number of sub-diagonals
+     */
+    GEOML_EXPORT SymmetricBandedMatrix(int n, int bandwidth);
+
+    /// Returns the number of rows and columns
+    GEOML_EXPORT int Size() const;
+
+    /// Returns the number of sub-diagonals
+    GEOML_EXPORT int Bandwidth() const;
+
+    /// Returns the entry A(i,j) of the lower band, i.e. it must hold 0 <= i-j <= bandwidth
+    GEOML_EXPORT double& operator()(int i, int j);
+
+    /// Returns the entry A(i,j). Entries outside the band are zero.
+    GEOML_EXPORT double operator()(int i, int j) const;
+
+    /**
+     * @brief Computes the Cholesky decomposition A = L*L^T in place
+     *
+     * @param relativePivotTolerance Pivots smaller than relativePivotTolerance times
+     *                               the largest diagonal entry are treated as zero
+     * @return false, if the matrix is not (numerically) positive definite
+     */
+    GEOML_EXPORT bool Factorize(double relativePivotTolerance = 1e-14);
+
+    /// Returns true, if the matrix has been successfully factorized
+    GEOML_EXPORT bool IsFactorized() const;
+
+    /// Solves A*x = b in place using the Cholesky decomposition
+    GEOML_EXPORT void Solve(math_Vector& b) const;
+
+    /**
+     * @brief Solves A*X = B in place for all columns of B at once
+     *
+     * This is used to solve for the x, y and z coordinates of points
+     * with a single pass over the decomposition.
+     */
+    GEOML_EXPORT void Solve(math_Matrix& B) const;
+
+    /// Returns the matrix as a dense math_Matrix
+    GEOML_EXPORT math_Matrix ToDense() const;
+
+private:
+    size_t index(int i, int j) const
+    {
+        return static_cast<size_t>(i - 1) * static_cast<size_t>(m_bandwidth + 1) + static_cast<size_t>(j - i + m_bandwidth);
+    }
+
+    int m_n;
+    int m_bandwidth;
+    bool m_factorized;
+    std::vector<double> m_data;
+};
+
+} // namespace geoml
@@ -85,16 +85,18 @@ namespace
     class BoundingBox
     {
     public:
-        BoundingBox(const Handle(Geom_BSplineCurve) curve)
-            : range(curve->FirstParameter(), curve->LastParameter())
+        /// Computes the bounding box of the control points given in homogeneous coordinates (x*w, y*w, z*w, w)
+        BoundingBox(const double* homogeneousPoles, int nPoles, double umin, double umax)
+            : range(umin, umax)
         {
             low.x = low.y = low.z = std::numeric_limits<double>::max();
             high.x = high.y = high.z = -std::numeric_limits<double>::max();
             // compute min / max from control points
-            for (Standard_Integer i = 1; i <= curve->NbPoles(); ++i) {
-                gp_XYZ p = curve->Pole(i).XYZ();
-                low = minCoords(low, p);
-                high = maxCoords(high, p);
+            for (int i = 0; i < nPoles; ++i) {
+                const double* p = homogeneousPoles + 4*i;
+                geoml::Point pnt(p[0]/p[3], p[1]/p[3], p[2]/p[3]);
+                low = minCoords(low, pnt);
+                high = maxCoords(high, pnt);
             }
         }
         
@@ -124,22 +126,6 @@ namespace
         Intervall range;
     };
 
-    // Computes the total curvature of the curve
-    // A curvature of 1 is equivalent to a straight line
-    double curvature(const Handle(Geom_BSplineCurve)& curve)
-    {
-        double len = curve->Pole(1).Distance(curve->Pole(curve->NbPoles()));
-        double total = 0.;
-        for (Standard_Integer i = 1; i < curve->NbPoles(); ++i) {
-            gp_Pnt p1 = curve->Pole(i);
-            gp_Pnt p2 = curve->Pole(i+1);
-            double dist = p1.Distance(p2);
-            total += dist;
-        }
-        
-        return total / len;
-    }
-    
     struct BoundingBoxPair
     {
         BoundingBoxPair (const BoundingBox& i1, const BoundingBox& i2)
@@ -149,75 +135,220 @@ namespace
         BoundingBox b2;
     };
 
-    
-    /// Computes possible ranges of intersections by a bracketing approach
-    std::list<BoundingBoxPair> getRangesOfIntersection(const Handle(Geom_BSplineCurve) curve1, const Handle(Geom_BSplineCurve) curve2, double tolerance)
+    /// A bezier segment of a curve, whose control points are stored in a BezierSegments arena
+    struct BezierSegment
     {
-        BoundingBox h1(curve1);
-        BoundingBox h2(curve2);
-        
-        if (!h1.Intersects(h2, tolerance)) {
-            // Bounding boxes do not intersect. No intersection possible
-            return {};
+        size_t offset; ///< index of the first coordinate of the first pole in the arena
+        double umin;   ///< parameter of the segment start on the original curve
+        double umax;   ///< parameter of the segment end on the original curve
+    };
+
+    /**
+     * @brief Stores the bezier segments of a B-spline curve in a flat buffer.
+     *
+     * Each segment consists of degree+1 poles in homogeneous coordinates (x*w, y*w, z*w, w).
+     * Segments created by subdivision are appended to the buffer and must be released
+     * in a stack-like manner. Hence, once the buffer has grown to the maximum recursion
+     * depth, the subdivision does not allocate any memory.
+     */
+    class BezierSegments
+    {
+    public:
+        explicit BezierSegments(const Handle(Geom_BSplineCurve)& curve)
+        {
+            // Decompose the curve into bezier segments by inserting
+            // all inner knots up to a multiplicity of the degree
+            Handle(Geom_BSplineCurve) bezierCurve = Handle(Geom_BSplineCurve)::DownCast(curve->Copy());
+            if (bezierCurve->IsPeriodic()) {
+                bezierCurve->SetNotPeriodic();
+            }
+
+            const int degree = bezierCurve->Degree();
+            if (bezierCurve->Multiplicity(1) < degree + 1 || bezierCurve->Multiplicity(bezierCurve->NbKnots()) < degree + 1) {
+                bezierCurve->Segment(bezierCurve->FirstParameter(), bezierCurve->LastParameter());
+            }
+            if (bezierCurve->NbKnots() > 2) {
+                bezierCurve->IncreaseMultiplicity(2, bezierCurve->NbKnots() - 1, degree);
+            }
+
+            m_nPoles = degree + 1;
+            const int nSegments = bezierCurve->NbKnots() - 1;
+            assert(bezierCurve->NbPoles() == nSegments * degree + 1);
+
+            // reserve enough memory for some levels of recursion
+            m_data.reserve(static_cast<size_t>(nSegments + 64) * Stride());
+            m_segments.reserve(static_cast<size_t>(nSegments));
+
+            for (int iseg = 0; iseg < nSegments; ++iseg) {
+                BezierSegment segment{m_data.size(), bezierCurve->Knot(iseg + 1), bezierCurve->Knot(iseg + 2)};
+                for (int ipole = 1; ipole <= m_nPoles; ++ipole) {
+                    const int poleIdx = iseg * degree + ipole;
+                    const double w = bezierCurve->Weight(poleIdx);
+                    const gp_Pnt p = bezierCurve->Pole(poleIdx);
+                    m_data.push_back(p.X() * w);
+                    m_data.push_back(p.Y() * w);
+                    m_data.push_back(p.Z() * w);
+                    m_data.push_back(w);
+                }
+                m_segments.push_back(segment);
+            }
         }
-        
-        double c1_curvature = curvature(curve1);
-        double c2_curvature = curvature(curve2);
-        double max_curvature = 1.0005;
-        
-        // If both curves are linear enough, we can stop refining
-        if (c1_curvature <= max_curvature && c2_curvature <= max_curvature) {
-            return {BoundingBoxPair(h1, h2)};
+
+        /// The bezier segments of the input curve
+        const std::vector<BezierSegment>& Segments() const
+        {
+            return m_segments;
         }
-        
-        double curve1MidParm = 0.5*(curve1->FirstParameter() + curve1->LastParameter());
-        double curve2MidParm = 0.5*(curve2->FirstParameter() + curve2->LastParameter());
-        
-        if (c1_curvature > max_curvature && c2_curvature > max_curvature) {
-            // Refine both curves by splitting them in the parametric center
-            Handle_Geom_BSplineCurve c11 = geoml::BSplineAlgorithms::trimCurve(curve1, curve1->FirstParameter(), curve1MidParm);
-            Handle_Geom_BSplineCurve c12 = geoml::BSplineAlgorithms::trimCurve(curve1, curve1MidParm, curve1->LastParameter());
-            
-            Handle_Geom_BSplineCurve c21 = geoml::BSplineAlgorithms::trimCurve(curve2, curve2->FirstParameter(), curve2MidParm);
-            Handle_Geom_BSplineCurve c22 = geoml::BSplineAlgorithms::trimCurve(curve2, curve2MidParm, curve2->LastParameter());
-            
-            auto result1 = getRangesOfIntersection(c11, c21, tolerance);
-            auto result2 = getRangesOfIntersection(c11, c22, tolerance);
-            auto result3 = getRangesOfIntersection(c12, c21, tolerance);
-            auto result4 = getRangesOfIntersection(c12, c22, tolerance);
-            
-            // append all results
-            result1.splice(std::begin(result1), result2);
-            result1.splice(std::begin(result1), result3);
-            result1.splice(std::begin(result1), result4);
-            
-            return result1;
+
+        /// Returns a marker of the current arena size, to be passed to Release
+        size_t Top() const
+        {
+            return m_data.size();
         }
-        else if (c1_curvature <= max_curvature && max_curvature < c2_curvature) {
-            // Refine only curve 2
-            Handle_Geom_BSplineCurve c21 = geoml::BSplineAlgorithms::trimCurve(curve2, curve2->FirstParameter(), curve2MidParm);
-            Handle_Geom_BSplineCurve c22 = geoml::BSplineAlgorithms::trimCurve(curve2, curve2MidParm, curve2->LastParameter());
-            
-            auto result1 = getRangesOfIntersection(curve1, c21, tolerance);
-            auto result2 = getRangesOfIntersection(curve1, c22, tolerance);
-            
-            result1.splice(std::begin(result1), result2);
-            return result1;
+
+        /// Releases all segments created after the marker top
+        void Release(size_t top)
+        {
+            m_data.resize(top);
         }
-        else if (c2_curvature <= max_curvature && max_curvature < c1_curvature) {
-            // Refine only curve 1
-            Handle_Geom_BSplineCurve c11 = geoml::BSplineAlgorithms::trimCurve(curve1, curve1->FirstParameter(), curve1MidParm);
-            Handle_Geom_BSplineCurve c12 = geoml::BSplineAlgorithms::trimCurve(curve1, curve1MidParm, curve1->LastParameter());
-            
-            auto result1 = getRangesOfIntersection(c11, curve2, tolerance);
-            auto result2 = getRangesOfIntersection(c12, curve2, tolerance);
-            
-            result1.splice(std::begin(result1), result2);
-            return result1;
+
+        /// Splits the segment in its parametric center using the de Casteljau algorithm
+        std::pair<BezierSegment, BezierSegment> Split(const BezierSegment& segment)
+        {
+            const size_t leftOffset = m_data.size();
+            const size_t rightOffset = leftOffset + Stride();
+            m_data.resize(rightOffset + Stride());
+
+            const double* src = m_data.data() + segment.offset;
+            double* left = m_data.data() + leftOffset;
+            double* right = m_data.data() + rightOffset;
+
+            // the right segment is computed in place. After the r-th step
+            // right[degree-r] contains the (degree-r)-th pole of the right segment
+            std::copy(src, src + Stride(), right);
+            std::copy(src, src + 4, left);
+            for (int r = 1; r < m_nPoles; ++r) {
+                for (int i = 0; i < 4*(m_nPoles - r); ++i) {
+                    right[i] = 0.5 * (right[i] + right[i + 4]);
+                }
+                std::copy(right, right + 4, left + 4*r);
+            }
+
+            const double umid = 0.5*(segment.umin + segment.umax);
+            return {BezierSegment{leftOffset, segment.umin, umid}, BezierSegment{rightOffset, umid, segment.umax}};
         }
-        
-        return {};
-    }
+
+        BoundingBox Box(const BezierSegment& segment) const
+        {
+            return BoundingBox(m_data.data() + segment.offset, m_nPoles, segment.umin, segment.umax);
+        }
+
+        // Computes the total curvature of the segment
+        // A curvature of 1 is equivalent to a straight line
+        double Curvature(const BezierSegment& segment) const
+        {
+            const double* p = m_data.data() + segment.offset;
+            auto pole = [p](int i) {
+                const double* h = p + 4*i;
+                return gp_Pnt(h[0]/h[3], h[1]/h[3], h[2]/h[3]);
+            };
+
+            double len = pole(0).Distance(pole(m_nPoles - 1));
+            double total = 0.;
+            for (int i = 0; i < m_nPoles - 1; ++i) {
+                total += pole(i).Distance(pole(i+1));
+            }
+
+            return total / len;
+        }
+
+    private:
+        size_t Stride() const
+        {
+            return 4 * static_cast<size_t>(m_nPoles);
+        }
+
+        int m_nPoles;
+        std::vector<double> m_data;
+        std::vector<BezierSegment> m_segments;
+    };
+
+    /// Computes possible ranges of intersections by a bracketing approach
+    class IntersectionRangeFinder
+    {
+    public:
+        IntersectionRangeFinder(const Handle(Geom_BSplineCurve)& curve1, const Handle(Geom_BSplineCurve)& curve2, double tolerance)
+            : m_curve1(curve1), m_curve2(curve2), m_tolerance(tolerance)
+        {}
+
+        std::vector<BoundingBoxPair> Perform()
+        {
+            std::vector<BoundingBoxPair> result;
+            for (const BezierSegment& s1 : m_curve1.Segments()) {
+                for (const BezierSegment& s2 : m_curve2.Segments()) {
+                    FindRanges(s1, s2, result);
+                }
+            }
+            return result;
+        }
+
+    private:
+        void FindRanges(const BezierSegment& s1, const BezierSegment& s2, std::vector<BoundingBoxPair>& result)
+        {
+            BoundingBox h1 = m_curve1.Box(s1);
+            BoundingBox h2 = m_curve2.Box(s2);
+
+            if (!h1.Intersects(h2, m_tolerance)) {
+                // Bounding boxes do not intersect. No intersection possible
+                return;
+            }
+
+            double c1_curvature = m_curve1.Curvature(s1);
+            double c2_curvature = m_curve2.Curvature(s2);
+            double max_curvature = 1.0005;
+
+            // If both curves are linear enough, we can stop refining
+            if (c1_curvature <= max_curvature && c2_curvature <= max_curvature) {
+                result.push_back(BoundingBoxPair(h1, h2));
+                return;
+            }
+
+            const size_t top1 = m_curve1.Top();
+            const size_t top2 = m_curve2.Top();
+
+            if (c1_curvature > max_curvature && c2_curvature > max_curvature) {
+                // Refine both curves by splitting them in the parametric center
+                auto c1 = m_curve1.Split(s1);
+                auto c2 = m_curve2.Split(s2);
+
+                FindRanges(c1.first, c2.first, result);
+                FindRanges(c1.first, c2.second, result);
+                FindRanges(c1.second, c2.first, result);
+                FindRanges(c1.second, c2.second, result);
+            }
+            else if (c1_curvature <= max_curvature && max_curvature < c2_curvature) {
+                // Refine only curve 2
+                auto c2 = m_curve2.Split(s2);
+
+                FindRanges(s1, c2.first, result);
+                FindRanges(s1, c2.second, result);
+            }
+            else if (c2_curvature <= max_curvature && max_curvature < c1_curvature) {
+                // Refine only curve 1
+                auto c1 = m_curve1.Split(s1);
+
+                FindRanges(c1.first, s2, result);
+                FindRanges(c1.second, s2, result);
+            }
+
+            m_curve1.Release(top1);
+            m_curve2.Release(top2);
+        }
+
+        BezierSegments m_curve1;
+        BezierSegments m_curve2;
+        double m_tolerance;
+    };
 
     class CurveCurveDistanceObjective : public math_MultipleVarFunctionWithGradient
     {
@@ -320,7 +451,7 @@ namespace geoml
 
 std::vector<geoml::CurveIntersectionResult> IntersectBSplines(const Handle(Geom_BSplineCurve) curve1, const Handle(Geom_BSplineCurve) curve2, double tolerance)
 {
-    auto hulls = getRangesOfIntersection(curve1, curve2, tolerance);
+    auto hulls = IntersectionRangeFinder(curve1, curve2, tolerance).Perform();
     
     std::list<BoundingBox> curve1_ints, curve2_ints;
     for (const auto& hull : hulls) {
@@ -22,28 +22,40 @@ void BRepBuilderAPI_MakeShape_Operation::map_subshapes(Shape& result)
 {
     auto result_subshapes = result.get_subshapes();
 
+    // index the result subshapes once, such that the origins can be
+    // resolved by lookups instead of comparing against all result subshapes
+    details::ShapeMap<Shape> result_index;
+    result_index.reserve(result_subshapes.size());
+    for (auto const& result_subshape : result_subshapes) {
+        result_index.emplace(result_subshape.shape(), result_subshape);
+    }
+
+    auto add_origin_to_result = [&](TopoDS_Shape const& s, Shape const& input_subshape) {
+        auto it = result_index.find(s);
+        if (it != result_index.end()) {
+            add_origin(it->second, input_subshape);
+        }
+    };
+
+    auto add_origin_to_results = [&](TopTools_ListOfShape const& shapes, Shape const& input_subshape) {
+        TopTools_ListIteratorOfListOfShape it;
+        for (it.Initialize(shapes); it.More(); it.Next()) {
+            add_origin_to_result(it.Value(), input_subshape);
+        }
+    };
+
     // map input origins to outputs
     for(auto const& shape : m_inputs) {
         for (auto const& input_subshape : shape.get_subshapes()) {
 
             // set origin for all unmodified shapes
-            for (auto& result_subshape : result_subshapes) {
-                if (result_subshape.is_same(input_subshape)){
-                    add_origin(result_subshape, input_subshape);
-                }
-            }
+            add_origin_to_result(input_subshape.shape(), input_subshape);
 
             // set origin for all modified shapes
-            TopTools_ListOfShape const& modified_by_this = m_algo.Modified(input_subshape);
-            TopTools_ListIteratorOfListOfShape it;
-            for (it.Initialize(modified_by_this); it.More(); it.Next()) {
-                for (auto& result_subshape : result_subshapes) {
-                    if (result_subshape.is_same(it.Value())) {
-                        add_origin(result_subshape, input_subshape);
-                    }
-                }
-            }
+            add_origin_to_results(m_algo.Modified(input_subshape), input_subshape);
 
+            // set origin for all generated shapes
+            add_origin_to_results(m_algo.Generated(input_subshape), input_subshape);
         }
     }
 }
@@ -39,7 +39,7 @@ public:
 protected:
 
     static void add_origin(Shape& output, Shape const& input){
-        output.m_data->origins.push_back(input);
+        output.m_data->add_origin(input);
     }
 
     std::vector<Shape> const m_inputs;
@@ -0,0 +1,130 @@
+#include <geoml/naming_choosing/Shape.h>
+#include <geoml/primitives/modeling.hpp>
+#include <geoml/boolean_ops/modeling.hpp>
+#include <geoml/predicates/predicate_functions.h>
+#include <geoml/transformations/transformations.h>
+
+#include <gtest/gtest.h>
+
+#include <BRepGProp.hxx>
+#include <GProp_GProps.hxx>
+#include <gp_Vec.hxx>
+
+#include <cmath>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+double volume(geoml::Shape const& shape)
+{
+    GProp_GProps props;
+    BRepGProp::VolumeProperties(shape, props);
+    return props.Mass();
+}
+
+} // namespace
+
+TEST(Test_boolean_options, options_give_same_result)
+{
+    using namespace geoml;
+
+    auto box = create_box(2., 2., 2.);
+    auto cylinder = create_cylinder(0.5, 4.);
+
+    BooleanOptions options;
+    options.run_parallel = true;
+    options.use_obb = true;
+    options.non_destructive = true;
+
+    EXPECT_NEAR(volume(boolean_subtract(box, cylinder)), volume(boolean_subtract(box, cylinder, options)), 1e-6);
+    EXPECT_NEAR(volume(boolean_union(box, cylinder)), volume(boolean_union(box, cylinder, options)), 1e-6);
+}
+
+TEST(Test_boolean_options, scoped_default)
+{
+    using namespace geoml;
+
+    EXPECT_FALSE(default_boolean_options().run_parallel);
+    {
+        BooleanOptions options;
+        options.run_parallel = true;
+        options.glue = BooleanGlue::shift;
+        ScopedBooleanOptions scope(options);
+
+        EXPECT_TRUE(default_boolean_options().run_parallel);
+        EXPECT_EQ(BooleanGlue::shift, default_boolean_options().glue);
+
+        auto result = create_box(1., 1., 1.) - create_cylinder(0.2, 2.);
+        EXPECT_GT(volume(result), 0.);
+    }
+    EXPECT_FALSE(default_boolean_options().run_parallel);
+    EXPECT_EQ(BooleanGlue::off, default_boolean_options().glue);
+}
+
+TEST(Test_boolean_options, default_per_thread)
+{
+    using namespace geoml;
+
+    BooleanOptions options;
+    options.run_parallel = true;
+    ScopedBooleanOptions scope(options);
+
+    // other threads keep their own default
+    bool other_run_parallel = true;
+    std::thread other([&other_run_parallel]() {
+        other_run_parallel = default_boolean_options().run_parallel;
+    });
+    other.join();
+
+    EXPECT_FALSE(other_run_parallel);
+    EXPECT_TRUE(default_boolean_options().run_parallel);
+}
+
+TEST(Test_boolean_union, multiple_shapes)
+{
+    using namespace geoml;
+
+    auto box = create_box(4., 1., 1.);
+    std::vector<Shape> shapes {box};
+    for (int i = 0; i < 4; ++i) {
+        shapes.push_back(Shape(translate(create_cylinder(0.3, 2.), gp_Vec(0.5 + i, 0.5, 0.))));
+    }
+
+    Shape chained = shapes.front();
+    for (size_t i = 1; i < shapes.size(); ++i) {
+        chained = chained + shapes[i];
+    }
+
+    Shape united = boolean_union(shapes);
+    EXPECT_NEAR(volume(chained), volume(united), 1e-6);
+
+    // the result has a history mapping to all inputs
+    for (auto const& shape : shapes) {
+        EXPECT_FALSE(united.select_subshapes(is_modified_descendent_of(shape)).is_empty() &&
+                     united.select_subshapes(is_descendent_of(shape)).is_empty());
+    }
+
+    EXPECT_THROW(boolean_union(std::vector<Shape>{}), geoml::Error);
+}
+
+TEST(Test_boolean_subtract, multiple_tools)
+{
+    using namespace geoml;
+
+    auto box = create_box(4., 1., 1.);
+    std::vector<Shape> tools;
+    for (int i = 0; i < 4; ++i) {
+        tools.push_back(Shape(translate(create_cylinder(0.3, 2.), gp_Vec(0.5 + i, 0.5, -0.5))));
+    }
+
+    Shape chained = box;
+    for (auto const& tool : tools) {
+        chained = chained - tool;
+    }
+
+    Shape cut = boolean_subtract(box, tools);
+    EXPECT_NEAR(volume(chained), volume(cut), 1e-6);
+    EXPECT_NEAR(4. - 4. * M_PI * 0.09, volume(cut), 1e-6);
+}
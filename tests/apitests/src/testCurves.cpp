@@ -314,6 +314,45 @@ TEST(Test_interpolate_points_to_b_spline_curve, interpolation_custom_parameters)
 
 }
 
+TEST(Test_interpolate_points_to_b_spline_curves, matches_single_interpolation)
+{
+    std::vector<std::vector<gp_Pnt>> point_sets;
+    for (int iset = 0; iset < 5; ++iset) {
+        double scale = 1. + 0.1 * iset;
+        point_sets.push_back({gp_Pnt(0.0, 0.0, 0.0),
+                              gp_Pnt(1.0 * scale, 0.0, 0.2 * iset),
+                              gp_Pnt(2.0, 0.5 * scale, 1.0),
+                              gp_Pnt(3.0, 0.0, 0.5 * scale),
+                              gp_Pnt(4.0, 1.0, 0.0)});
+    }
+    // a closed point set
+    point_sets.push_back({gp_Pnt(0.0, 0.0, 0.0),
+                          gp_Pnt(1.0, 0.0, 0.0),
+                          gp_Pnt(1.0, 1.0, 0.0),
+                          gp_Pnt(0.0, 1.0, 0.5),
+                          gp_Pnt(0.0, 0.0, 0.0)});
+
+    std::vector<Standard_Real> params {0., 0.2, 0.5, 0.7, 1.};
+
+    std::vector<Handle(Geom_BSplineCurve)> curves =
+    geoml::interpolate_points_to_b_spline_curves(point_sets, 3, true, params);
+
+    ASSERT_EQ(curves.size(), point_sets.size());
+    for (size_t iset = 0; iset < point_sets.size(); ++iset) {
+        Handle(Geom_BSplineCurve) reference =
+        geoml::interpolate_points_to_b_spline_curve(point_sets[iset], 3, true, params);
+
+        ASSERT_EQ(curves[iset]->NbPoles(), reference->NbPoles());
+        EXPECT_EQ(curves[iset]->Degree(), reference->Degree());
+        for (int ipole = 1; ipole <= reference->NbPoles(); ++ipole) {
+            EXPECT_NEAR(curves[iset]->Pole(ipole).Distance(reference->Pole(ipole)), 0., 1e-10);
+        }
+        for (size_t ipnt = 0; ipnt < params.size(); ++ipnt) {
+            EXPECT_NEAR(curves[iset]->Value(params[ipnt]).Distance(point_sets[iset][ipnt]), 0., 1e-8);
+        }
+    }
+}
+
 gp_Vec displacement_of_third_control_point(int degree, Standard_Real beta, Standard_Real gamma, gp_Vec first_derivative, gp_Vec second_derivative)
 {
     gp_Vec vec = (beta * beta * degree /(degree - 1)) * second_derivative;
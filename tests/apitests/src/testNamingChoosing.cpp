@@ -16,8 +16,12 @@
 #include <BRepBuilderAPI_MakeEdge.hxx>
 #include <BRepPrimAPI_MakePrism.hxx>
 #include <BRepPrimAPI_MakeBox.hxx>
+#include <BRepGProp.hxx>
+#include <GProp_GProps.hxx>
 #include <TopoDS.hxx>
 
+#include <cmath>
+
 TEST(Shape, add_persistent_meta_tag_to_subshapes)
 {
     using namespace geoml;
@@ -33,6 +37,250 @@ TEST(Shape, add_persistent_meta_tag_to_subshapes)
     }
 }
 
+TEST(Shape, interned_tags)
+{
+    using namespace geoml;
+    auto box = create_box(1., 1., 1.);
+
+    EXPECT_EQ(intern_tag("interned_tags_a"), intern_tag("interned_tags_a"));
+    EXPECT_NE(intern_tag("interned_tags_a"), intern_tag("interned_tags_b"));
+
+    EXPECT_FALSE(box.has_tag("interned_tags_never_added"));
+    box.add_meta_tag("interned_tags_a");
+    box.add_meta_tag("interned_tags_a");
+    EXPECT_TRUE(box.has_tag("interned_tags_a"));
+    EXPECT_TRUE(box.has_tag(intern_tag("interned_tags_a")));
+    EXPECT_FALSE(box.has_tag("interned_tags_b"));
+
+    // many tags on a single shape
+    for (int i = 0; i < 200; ++i) {
+        box.add_meta_tag("interned_tags_" + std::to_string(i));
+    }
+    for (int i = 0; i < 200; ++i) {
+        EXPECT_TRUE(box.has_tag("interned_tags_" + std::to_string(i)));
+    }
+    EXPECT_FALSE(box.has_tag("interned_tags_b"));
+
+    // tags added in any order, including duplicates
+    auto face = box.get_subshapes_of_type(TopAbs_FACE)[0];
+    for (int i = 199; i >= 0; i -= 2) {
+        face.add_meta_tag("interned_tags_" + std::to_string(i));
+        face.add_meta_tag("interned_tags_" + std::to_string(i));
+    }
+    for (int i = 0; i < 200; ++i) {
+        EXPECT_EQ(face.has_tag("interned_tags_" + std::to_string(i)), i % 2 == 1);
+    }
+}
+
+TEST(Shape, lazy_children_keep_their_data)
+{
+    using namespace geoml;
+    auto box = create_box(1., 1., 1.);
+
+    // the solid has a single shell, which is created on first access
+    ASSERT_EQ(box.direct_subshapes().size(), 1);
+    EXPECT_EQ(box.direct_subshapes()[0].direct_subshapes().size(), 6);
+
+    // tags added to children must be visible on subsequent accesses
+    box[0].add_meta_tag("shell");
+    EXPECT_TRUE(box[0].has_tag("shell"));
+    EXPECT_EQ(box.select_subshapes(has_tag("shell")).size(), 1);
+
+    add_persistent_meta_tag_to_subshapes(box, is_face, "face");
+    EXPECT_EQ(box.select_subshapes(has_tag("face")).size(), 6);
+}
+
+TEST(Shape, indexed_subshapes)
+{
+    using namespace geoml;
+    auto box = create_box(1., 1., 1.);
+
+    EXPECT_EQ(box.get_subshapes_of_type(TopAbs_SOLID).size(), 1);
+    EXPECT_EQ(box.get_subshapes_of_type(TopAbs_FACE).size(), 6);
+    EXPECT_EQ(box.get_subshapes_of_type(TopAbs_EDGE).size(), 12);
+    EXPECT_EQ(box.get_subshapes_of_type(TopAbs_VERTEX).size(), 8);
+    EXPECT_EQ(box.get_subshapes().size(), 1 + 1 + 6 + 6 + 12 + 8);
+
+    // the index returns the same shapes as the topology tree
+    auto faces = box.get_subshapes_of_type(TopAbs_FACE);
+    faces[0].add_meta_tag("first");
+    EXPECT_EQ(box.select_subshapes(has_tag("first")).size(), 1);
+    for (auto const& face : faces) {
+        EXPECT_TRUE(box.has_subshape(face));
+    }
+
+    auto other_box = create_box(1., 1., 1.);
+    EXPECT_FALSE(box.has_subshape(other_box.get_subshapes_of_type(TopAbs_FACE)[0]));
+
+    // the index is rebuilt after modifying the topology
+    auto children = box.direct_subshapes();
+    children.push_back(other_box);
+    box.set_direct_subshapes(std::move(children));
+    EXPECT_TRUE(box.has_subshape(other_box.get_subshapes_of_type(TopAbs_FACE)[0]));
+    EXPECT_EQ(box.get_subshapes_of_type(TopAbs_FACE).size(), 12);
+}
+
+TEST(Shape, indexed_subshapes_after_replacing_children)
+{
+    using namespace geoml;
+    auto box = create_box(1., 1., 1.);
+    auto other_box = create_box(2., 2., 2.);
+    auto other_face = other_box.get_subshapes_of_type(TopAbs_FACE)[0];
+    EXPECT_FALSE(box.has_subshape(other_face));
+
+    // iterating over the children does not modify the topology
+    for (auto& child : box) {
+        EXPECT_FALSE(child.is_null());
+    }
+    EXPECT_FALSE(box.has_subshape(other_face));
+
+    // the index is rebuilt after replacing a child
+    box.set_direct_subshapes({other_box[0]});
+    EXPECT_TRUE(box.has_subshape(other_face));
+
+    // ... also, if the children of a subshape of the indexed shape are replaced
+    auto third_box = create_box(3., 3., 3.);
+    auto third_face = third_box.get_subshapes_of_type(TopAbs_FACE)[0];
+    Shape shell = box[0];
+    shell.set_direct_subshapes({third_face});
+    EXPECT_TRUE(box.has_subshape(third_face));
+    EXPECT_FALSE(box.has_subshape(other_face));
+}
+
+TEST(Shape, select_subshapes_order)
+{
+    using namespace geoml;
+    auto box = create_box(1., 1., 1.);
+    auto faces = box.get_subshapes_of_type(TopAbs_FACE);
+    ASSERT_EQ(faces.size(), 6);
+
+    // shallow and deep searches return the subshapes in depth first order
+    auto is_face_lambda = [](Shape const& s) { return s.shape().ShapeType() == TopAbs_FACE; };
+    auto shallow = faces.select_subshapes(is_face_lambda, 1);
+    auto deep = faces.select_subshapes(is_face_lambda);
+    auto typed = faces.select_subshapes(is_face);
+    ASSERT_EQ(shallow.size(), 6);
+    ASSERT_EQ(deep.size(), 6);
+    ASSERT_EQ(typed.size(), 6);
+    for (int i = 0; i < 6; ++i) {
+        EXPECT_TRUE(shallow[i].is_same(faces[i]));
+        EXPECT_TRUE(deep[i].is_same(faces[i]));
+        EXPECT_TRUE(typed[i].is_same(faces[i]));
+    }
+}
+
+TEST(Shape, shared_subshapes)
+{
+    using namespace geoml;
+    auto box = create_box(1., 1., 1.);
+
+    // tag a vertex, which is shared by multiple edges
+    auto vertex = box.get_subshapes_of_type(TopAbs_VERTEX)[0];
+    vertex.add_meta_tag("vertex");
+
+    // all occurrences of the vertex in the topology tree share the tag
+    int occurrences = 0;
+    std::function<void(Shape const&)> check = [&](Shape const& s) {
+        if (s.shape().IsEqual(vertex.shape())) {
+            ++occurrences;
+            EXPECT_TRUE(s.has_tag("vertex"));
+        }
+        for (auto const& child : s.direct_subshapes()) {
+            check(child);
+        }
+    };
+    check(box);
+    EXPECT_GT(occurrences, 1);
+
+    // an edge is shared by two faces in opposite orientations
+    auto faces = box.get_subshapes_of_type(TopAbs_FACE);
+    auto edge = faces[0].get_subshapes_of_type(TopAbs_EDGE)[0];
+    edge.add_meta_tag("edge");
+
+    int adjacent_faces = 0;
+    for (auto const& face : faces) {
+        for (auto const& other : face.get_subshapes_of_type(TopAbs_EDGE)) {
+            if (other.is_same(edge)) {
+                ++adjacent_faces;
+                EXPECT_TRUE(other.has_tag("edge"));
+            }
+        }
+    }
+    EXPECT_EQ(adjacent_faces, 2);
+
+    // the tag is visible through the occurrence in the other orientation
+    auto reversed = box.select_subshapes([&](Shape const& s) {
+        return s.is_same(edge) && s.shape().Orientation() != edge.shape().Orientation();
+    });
+    ASSERT_FALSE(reversed.is_null());
+    EXPECT_TRUE(reversed.has_tag("edge"));
+
+    // typed predicates check all occurrences of a subshape as well
+    TopAbs_Orientation orientation = reversed.shape().Orientation();
+    ShapePredicate has_orientation([=](Shape const& s) { return s.shape().Orientation() == orientation; });
+    auto typed = box.select_subshapes(is_edge && has_tag("edge") && has_orientation);
+    ASSERT_EQ(typed.size(), 1);
+    EXPECT_EQ(typed[0].shape().Orientation(), orientation);
+}
+
+TEST(Shape, history_max_depth)
+{
+    using namespace geoml;
+
+    auto center_z = [](Shape const& s) {
+        GProp_GProps props;
+        BRepGProp::SurfaceProperties(s.shape(), props);
+        return props.CentreOfMass().Z();
+    };
+    auto bottom_faces = [&](Shape const& s) {
+        std::vector<Shape> faces;
+        for (auto const& face : s.get_subshapes_of_type(TopAbs_FACE)) {
+            if (std::abs(center_z(face)) < 1e-6) {
+                faces.push_back(face);
+            }
+        }
+        return faces;
+    };
+
+    // two cuts, each modifying the bottom face of the box
+    auto box = create_box(1., 1., 1.);
+    Shape tool1(BRepPrimAPI_MakeBox(gp_Pnt(0., 0., 0.), 0.5, 0.5, 0.5).Shape());
+    Shape tool2(BRepPrimAPI_MakeBox(gp_Pnt(0.5, 0., 0.), 0.5, 0.5, 0.5).Shape());
+    Shape cut1 = box - tool1;
+    Shape cut2 = cut1 - tool2;
+
+    auto box_bottom = bottom_faces(box);
+    ASSERT_EQ(box_bottom.size(), 1);
+    auto cut2_bottom = bottom_faces(cut2);
+    ASSERT_EQ(cut2_bottom.size(), 1);
+
+    auto const& face = cut2_bottom[0];
+    EXPECT_TRUE(face.is_descendent_of(box_bottom[0]));
+    EXPECT_TRUE(face.is_modified_descendent_of(box_bottom[0]));
+    EXPECT_TRUE(face.is_descendent_of(box_bottom[0], 2));
+    EXPECT_FALSE(face.is_descendent_of(box_bottom[0], 1));
+    EXPECT_FALSE(face.is_descendent_of(box_bottom[0], -1));
+    EXPECT_TRUE(box_bottom[0].is_ancestor_of(face, 2));
+    EXPECT_FALSE(box_bottom[0].is_ancestor_of(face, 1));
+    EXPECT_TRUE(face.is_descendent_of_subshape_in(box, 2));
+    EXPECT_FALSE(face.is_descendent_of_subshape_in(box, 1));
+    EXPECT_TRUE(face.is_modified_descendent_of_subshape_in(box, 2));
+    EXPECT_FALSE(face.is_unmodified_descendent_of_subshape_in(box));
+
+    // a shape is its own unmodified descendent
+    EXPECT_TRUE(face.is_unmodified_descendent_of(face, 0));
+    EXPECT_TRUE(face.is_unmodified_descendent_of_subshape_in(cut2, 0));
+    EXPECT_FALSE(face.is_modified_descendent_of(face));
+
+    // the cached distances are updated after extending the history
+    Shape tool3(BRepPrimAPI_MakeBox(gp_Pnt(0., 0.5, 0.), 0.25, 0.25, 0.25).Shape());
+    Shape cut3 = cut2 - tool3;
+    auto cut3_bottom = bottom_faces(cut3);
+    ASSERT_EQ(cut3_bottom.size(), 1);
+    EXPECT_TRUE(cut3_bottom[0].is_descendent_of(box_bottom[0], 3));
+    EXPECT_FALSE(cut3_bottom[0].is_descendent_of(box_bottom[0], 2));
+}
+
 // Currently, an edge is picked via an index, which is dependant of a hash function, which is used in the context of ShapeContainers, which is a typedef 
 // of std::unordered_set. For hash is calculated with ShapeHasher, which uses, amongs other inputs, the address of the TShape instance of the 
 // underlying TopoDS_Shape instance. Each execution of the tests may lead to different addresses allocated by the operational system (depending
@@ -348,6 +596,83 @@ TEST_F(RectangularFace, test_shape_predicates)
     EXPECT_EQ(rectangular_srf_edges_with_tag.size(), 4);
 }
 
+TEST(ShapePredicate, compiled_expressions)
+{
+    using namespace geoml;
+    auto box = create_box(1., 1., 1.);
+    auto faces = box.get_subshapes_of_type(TopAbs_FACE);
+    faces[0].add_meta_tag("compiled_a");
+    faces[1].add_meta_tag("compiled_a");
+    faces[1].add_meta_tag("compiled_b");
+
+    int calls = 0;
+    ShapePredicate counting([&](Shape const&) { ++calls; return true; });
+
+    // type checks are merged and determine the candidate types
+    EXPECT_EQ((is_face || is_edge).type_mask(), (1u << TopAbs_FACE) | (1u << TopAbs_EDGE));
+    EXPECT_EQ((is_face && counting).type_mask(), 1u << TopAbs_FACE);
+    EXPECT_EQ((!is_vertex).type_mask(), details::all_shape_types & ~(1u << TopAbs_VERTEX));
+    EXPECT_EQ((is_face && is_edge).type_mask(), 0u);
+    EXPECT_EQ(counting.type_mask(), details::all_shape_types);
+
+    // the function is only called for faces, although it is the first operand
+    EXPECT_EQ(box.select_subshapes(counting && is_face).size(), 6);
+    EXPECT_EQ(calls, 6);
+
+    // the results equal the ones of the equivalent function
+    std::vector<ShapePredicate> predicates = {
+        is_face && has_tag("compiled_a"),
+        has_tag("compiled_a") && !has_tag("compiled_b"),
+        (is_face || is_edge) && !has_tag("compiled_a"),
+        !(!is_vertex),
+        is_edge || has_tag("compiled_b") || is_vertex,
+        is_face && is_edge
+    };
+    std::vector<std::function<bool(Shape const&)>> functions = {
+        [](Shape const& s) { return s.is_type(TopAbs_FACE) && s.has_tag("compiled_a"); },
+        [](Shape const& s) { return s.has_tag("compiled_a") && !s.has_tag("compiled_b"); },
+        [](Shape const& s) { return (s.is_type(TopAbs_FACE) || s.is_type(TopAbs_EDGE)) && !s.has_tag("compiled_a"); },
+        [](Shape const& s) { return s.is_type(TopAbs_VERTEX); },
+        [](Shape const& s) { return s.is_type(TopAbs_EDGE) || s.has_tag("compiled_b") || s.is_type(TopAbs_VERTEX); },
+        [](Shape const&) { return false; }
+    };
+    for (size_t i = 0; i < predicates.size(); ++i) {
+        auto expected = box.select_subshapes(functions[i]);
+        auto selected = box.select_subshapes(predicates[i]);
+        ASSERT_EQ(expected.size(), selected.size());
+        for (size_t j = 0; j < expected.size(); ++j) {
+            EXPECT_TRUE(expected[j].is_same(selected[j]));
+        }
+        for (auto const& subshape : box.get_subshapes()) {
+            EXPECT_EQ(functions[i](subshape), predicates[i](subshape));
+        }
+    }
+}
+
+TEST(ShapePredicate, functions_keep_their_order)
+{
+    using namespace geoml;
+    auto box = create_box(1., 1., 1.);
+
+    // the guards are functions, hence they are not known to be cheap type checks
+    ShapePredicate guard1([](Shape const& s) { return s.is_type(TopAbs_FACE); });
+    ShapePredicate guard2([](Shape const& s) { return s.is_type(TopAbs_EDGE); });
+
+    // f must only be called for shapes satisfying one of the guards
+    int violations = 0;
+    ShapePredicate f([&](Shape const& s) {
+        if (!s.is_type(TopAbs_FACE) && !s.is_type(TopAbs_EDGE)) {
+            ++violations;
+        }
+        return true;
+    });
+
+    EXPECT_EQ(box.select_subshapes((guard1 || guard2) && f).size(), 6 + 12);
+    EXPECT_EQ(box.select_subshapes(guard1 && f).size(), 6);
+    EXPECT_EQ(box.select_subshapes(!(!guard2 || !f)).size(), 12);
+    EXPECT_EQ(violations, 0);
+}
+
 
 struct PredicateSelection
  : public RectangularFace
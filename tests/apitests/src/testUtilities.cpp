@@ -216,4 +216,38 @@ TEST(Test_make_fillet, simple_make_fillet_test)
 
     // make sure that area_cut_face is not zero
     EXPECT_NEAR(area_selected_face - area_des_of_selected_face, 0.4275, 1e-3);
-}
\ No newline at end of file
+}
+
+TEST(Test_make_fillet, origins_of_generated_faces)
+{
+    using namespace geoml;
+
+    Shape my_box = BRepPrimAPI_MakeBox(gp_Pnt(0., 0., 0.), gp_Pnt(1., 2., 3.)).Solid();
+    Shape edge = my_box.get_subshapes_of_type(TopAbs_EDGE)[0];
+
+    Shape filleted_box = make_fillet(my_box, edge, 0.1);
+    Shape faces = filleted_box.get_subshapes_of_type(TopAbs_FACE);
+    EXPECT_EQ(faces.size(), 7);
+
+    // the fillet face is generated from the edge
+    Shape fillet_faces = filleted_box.select_subshapes(is_face && is_descendent_of(edge, 1));
+    ASSERT_EQ(fillet_faces.size(), 1);
+    EXPECT_TRUE(fillet_faces[0].is_modified_descendent_of(edge));
+    EXPECT_FALSE(my_box.has_subshape(fillet_faces[0]));
+
+    // all other faces are modified or unmodified faces of the box
+    int unmodified = 0;
+    for (auto const& face : faces) {
+        if (face.is_same(fillet_faces[0])) {
+            continue;
+        }
+        EXPECT_TRUE(face.is_descendent_of_subshape_in(my_box, 1));
+        EXPECT_FALSE(face.is_descendent_of(edge));
+        if (face.is_unmodified_descendent_of_subshape_in(my_box)) {
+            ++unmodified;
+        }
+    }
+
+    // the faces, that do not touch the edge, are not modified
+    EXPECT_GE(unmodified, 1);
+}
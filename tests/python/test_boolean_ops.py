@@ -33,4 +33,51 @@ def test_boolean_ops():
     united_shape_1 = box_shape + sphere_shape
     assert type(united_shape_1) is pygeoml.Shape
 
-    
\ No newline at end of file
+    
+
+def test_boolean_ops_with_options():
+
+    box = BRepPrimAPI_MakeBox(10.0, 10.0, 10.0).Shape()
+    sphere = BRepPrimAPI_MakeSphere(5.0).Shape()
+
+    box_shape = pygeoml.Shape(box)
+    sphere_shape = pygeoml.Shape(sphere)
+
+    options = pygeoml.BooleanOptions()
+    options.run_parallel = True
+    options.use_obb = True
+    options.fuzzy_value = 1e-6
+
+    # test: Shape boolean_subtract(Shape const& shape, Shape const& cutting_tool, BooleanOptions const& options);
+    subtracted_shape = pygeoml.boolean_subtract(box_shape, sphere_shape, options)
+    assert type(subtracted_shape) is pygeoml.Shape
+
+    # test: Shape boolean_union(Shape const& shape_1, Shape const& shape_2, BooleanOptions const& options);
+    united_shape = pygeoml.boolean_union(box_shape, sphere_shape, options)
+    assert type(united_shape) is pygeoml.Shape
+
+    # test: the default options are used by the operators
+    previous = pygeoml.default_boolean_options()
+    pygeoml.set_default_boolean_options(options)
+    assert pygeoml.default_boolean_options().run_parallel
+    united_shape_1 = box_shape + sphere_shape
+    assert type(united_shape_1) is pygeoml.Shape
+    pygeoml.set_default_boolean_options(previous)
+    assert not pygeoml.default_boolean_options().run_parallel
+
+
+def test_boolean_ops_multiple_shapes():
+
+    box = pygeoml.Shape(BRepPrimAPI_MakeBox(10.0, 10.0, 10.0).Shape())
+    sphere_1 = pygeoml.Shape(BRepPrimAPI_MakeSphere(5.0).Shape())
+    sphere_2 = pygeoml.Shape(BRepPrimAPI_MakeSphere(3.0).Shape())
+
+    shapes = pygeoml.ShapeList([box, sphere_1, sphere_2])
+
+    # test: Shape boolean_union(std::vector<Shape> const& shapes);
+    united_shape = pygeoml.boolean_union(shapes)
+    assert type(united_shape) is pygeoml.Shape
+
+    # test: Shape boolean_subtract(Shape const& shape, std::vector<Shape> const& cutting_tools);
+    subtracted_shape = pygeoml.boolean_subtract(box, pygeoml.ShapeList([sphere_1, sphere_2]))
+    assert type(subtracted_shape) is pygeoml.Shape
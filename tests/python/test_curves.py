@@ -76,6 +76,19 @@ def test_interpolate_points_to_b_spline_curve():
     assert type(result) is Geom_BSplineCurve
 
 
+def test_interpolate_points_to_b_spline_curves():
+
+    point_list_1 = [gp_Pnt(0,0,0), gp_Pnt(0.5,0,0), gp_Pnt(1,1,0)]
+    point_list_2 = [gp_Pnt(0,0,1), gp_Pnt(0.5,0,1), gp_Pnt(1,1,1)]
+
+    point_sets = pygeoml.CPointContainerList([containers.point_vector(point_list_1), containers.point_vector(point_list_2)])
+
+    result = pygeoml.interpolate_points_to_b_spline_curves(point_sets, 2)
+    assert len(result) == 2
+    for curve in result:
+        assert type(curve) is Geom_BSplineCurve
+
+
 ###########################################################################
 ##################### test geoml/curves/BlendCurve.h ##########################
 ###########################################################################
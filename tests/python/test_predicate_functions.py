@@ -127,16 +127,16 @@ def test_predicate_functions_h():
     pred = pygeoml.has_subshape_that(pred_is_edge)
     assert pred(edge_shape) == True
 
-    # test: ShapePredicate const is_vertex = ShapePredicate(&details::_is_vertex);
+    # test: ShapePredicate const is_vertex = is_type(TopAbs_VERTEX);
     assert pygeoml.is_vertex(edge_shape) == False
 
-    # test: ShapePredicate const is_edge = ShapePredicate(&details::_is_edge);
+    # test: ShapePredicate const is_edge = is_type(TopAbs_EDGE);
     assert pygeoml.is_edge(edge_shape) == True
 
-    # test: ShapePredicate const is_face = ShapePredicate(&details::_is_face);
+    # test: ShapePredicate const is_face = is_type(TopAbs_FACE);
     assert pygeoml.is_face(edge_shape) == False
 
-    # test: ShapePredicate const is_solid = ShapePredicate(&details::_is_solid);
+    # test: ShapePredicate const is_solid = is_type(TopAbs_SOLID);
     assert pygeoml.is_solid(edge_shape) == False
 
     # test: ShapePredicate const is_has_origin = ShapePredicate(&details::_has_origin);
@@ -44,6 +44,11 @@ def test_Shape_h():
     edge_shape.get_subshapes()
     assert type(edge_shape) is pygeoml.Shape
 
+    # test: Shape get_subshapes_of_type(TopAbs_ShapeEnum shape_type) const;
+    assert edge_shape.get_subshapes_of_type(TopAbs_EDGE).size() == 1
+    assert edge_shape.get_subshapes_of_type(TopAbs_VERTEX).size() == 2
+    assert edge_shape.get_subshapes_of_type(TopAbs_FACE).size() == 0
+
     # test: void add_meta_tag(std::string const& tag);
     edge_shape.add_meta_tag("added_tag")
     assert type(edge_shape) is pygeoml.Shape
@@ -186,3 +186,38 @@ def test_create_face():
     result = pygeoml.create_face(x,y,z,w)
     assert type(result) is TopoDS_Face
 
+
+
+def test_evaluate_surface_grid():
+    control_points = pygeoml.Array2dgp_Pnt(2, 2)
+    control_points.setValue(0, 0, gp_Pnt(0.0, 0.0, 0.0))
+    control_points.setValue(0, 1, gp_Pnt(0.0, 1.0, 0.0))
+    control_points.setValue(1, 0, gp_Pnt(1.0, 0.0, 0.0))
+    control_points.setValue(1, 1, gp_Pnt(1.0, 1.0, 0.0))
+
+    weights = pygeoml.Array2dStandardReal(2, 2)
+    for i in range(2):
+        for j in range(2):
+            weights.setValue(i, j, 1.0)
+
+    surface = pygeoml.nurbs_surface(control_points, weights,
+                                    containers.standard_real_vector([0., 1.]),
+                                    containers.standard_real_vector([0., 1.]),
+                                    containers.int_vector([2, 2]),
+                                    containers.int_vector([2, 2]),
+                                    1, 1)
+
+    u = containers.standard_real_vector([0., 0.5, 1.])
+    v = containers.standard_real_vector([0., 1.])
+    result = pygeoml.evaluate_surface_grid(surface, u, v, True, True)
+
+    assert result.nu == 3
+    assert result.nv == 2
+    assert len(result.x) == 6
+    assert len(result.du_x) == 6
+    assert abs(result.x[2] - 0.5) < 1e-10
+    assert abs(result.y[3] - 1.0) < 1e-10
+    for i in range(6):
+        assert abs(result.z[i]) < 1e-10
+        assert abs(result.du_x[i] - 1.0) < 1e-10
+        assert abs(result.normal_z[i] - 1.0) < 1e-10
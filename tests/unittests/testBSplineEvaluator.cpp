@@ -0,0 +1,187 @@
+/*
+* Copyright (C) 2026 German Aerospace Center (DLR/SC)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "test.h"
+
+#include <Geom_BSplineCurve.hxx>
+#include <Geom_BSplineSurface.hxx>
+#include <Geom_Circle.hxx>
+#include <Geom_TrimmedCurve.hxx>
+#include <GeomConvert.hxx>
+#include <TColgp_Array2OfPnt.hxx>
+#include <TColStd_Array2OfReal.hxx>
+#include <gp_Ax2.hxx>
+
+#include "geometry/BSplineEvaluator.h"
+#include "common/CommonFunctions.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+
+Handle(Geom_BSplineCurve) curveOfDegree(int degree)
+{
+    // uniform, clamped curve with a double inner knot
+    const int nPoles = 2 * degree + 3;
+    std::vector<gp_Pnt> poles;
+    for (int i = 0; i < nPoles; ++i) {
+        poles.push_back(gp_Pnt(i, std::sin(1.3 * i), std::cos(0.7 * i)));
+    }
+
+    std::vector<double> knots {0., 0.5, 1., 2.};
+    std::vector<int> mults {degree + 1, 1, std::min(2, degree), degree + 1};
+    int nInner = nPoles + degree + 1 - 2 * (degree + 1) - 1 - std::min(2, degree);
+    for (int i = 0; i < nInner; ++i) {
+        knots.insert(knots.end() - 1, 1.1 + 0.8 * (i + 1) / (nInner + 1));
+        mults.insert(mults.end() - 1, 1);
+    }
+
+    return new Geom_BSplineCurve(OccArray(poles)->Array1(), OccFArray(knots)->Array1(), OccIArray(mults)->Array1(), degree);
+}
+
+void checkCurve(const Handle(Geom_BSplineCurve)& curve)
+{
+    geoml::BSplineCurveEvaluator evaluator(curve);
+    double umin = curve->FirstParameter();
+    double umax = curve->LastParameter();
+    for (int i = 0; i <= 100; ++i) {
+        double u = umin + (umax - umin) * i / 100.;
+        EXPECT_NEAR(0., evaluator.Value(u).Distance(curve->Value(u)), 1e-10) << "degree " << curve->Degree() << ", u = " << u;
+    }
+}
+
+} // namespace
+
+TEST(BSplineEvaluator, curveDegrees)
+{
+    for (int degree = 1; degree <= 7; ++degree) {
+        checkCurve(curveOfDegree(degree));
+    }
+}
+
+TEST(BSplineEvaluator, rationalCurve)
+{
+    Handle(Geom_Circle) circle = new Geom_Circle(gp_Ax2(gp_Pnt(0., 0., 0.), gp_Dir(0., 0., 1.)), 1.);
+    Handle(Geom_BSplineCurve) curve = GeomConvert::CurveToBSplineCurve(new Geom_TrimmedCurve(circle, 0., 1.5 * M_PI));
+    ASSERT_TRUE(curve->IsRational());
+    checkCurve(curve);
+
+    geoml::BSplineCurveEvaluator evaluator(curve);
+    EXPECT_NEAR(1., evaluator.Value(0.3).Distance(gp_Pnt(0., 0., 0.)), 1e-12);
+}
+
+TEST(BSplineEvaluator, periodicCurve)
+{
+    auto poles = OccArray({gp_Pnt(0., 0., 0.), gp_Pnt(1., 0., 0.), gp_Pnt(2., 1., 0.),
+                           gp_Pnt(1., 2., 1.), gp_Pnt(0., 2., 0.), gp_Pnt(-1., 1., 0.)});
+    auto knots = OccFArray({0., 1., 2., 3., 4., 5., 6.});
+    auto mults = OccIArray({1, 1, 1, 1, 1, 1, 1});
+    Handle(Geom_BSplineCurve) curve = new Geom_BSplineCurve(poles->Array1(), knots->Array1(), mults->Array1(), 3, true);
+    ASSERT_TRUE(curve->IsPeriodic());
+    checkCurve(curve);
+}
+
+TEST(BSplineEvaluator, surface)
+{
+    for (int udegree = 1; udegree <= 4; ++udegree) {
+        for (int vdegree = 1; vdegree <= 4; ++vdegree) {
+            const int nu = udegree + 3;
+            const int nv = vdegree + 2;
+            TColgp_Array2OfPnt poles(1, nu, 1, nv);
+            for (int i = 1; i <= nu; ++i) {
+                for (int j = 1; j <= nv; ++j) {
+                    poles(i, j) = gp_Pnt(i, j, std::sin(i * j * 0.3));
+                }
+            }
+            auto uknots = OccFArray({0., 0.3, 0.5, 1.});
+            auto umults = OccIArray({udegree + 1, 1, 1, udegree + 1});
+            auto vknots = OccFArray({0., 0.7, 1.});
+            auto vmults = OccIArray({vdegree + 1, 1, vdegree + 1});
+
+            Handle(Geom_BSplineSurface) surface = new Geom_BSplineSurface(poles, uknots->Array1(), vknots->Array1(),
+                                                                          umults->Array1(), vmults->Array1(), udegree, vdegree);
+            geoml::BSplineSurfaceEvaluator evaluator(surface);
+            for (int i = 0; i <= 10; ++i) {
+                for (int j = 0; j <= 10; ++j) {
+                    double u = i / 10.;
+                    double v = j / 10.;
+                    EXPECT_NEAR(0., evaluator.Value(u, v).Distance(surface->Value(u, v)), 1e-10);
+                }
+            }
+        }
+    }
+}
+
+TEST(BSplineEvaluator, surfaceGrid)
+{
+    const int udegree = 3;
+    const int vdegree = 2;
+    const int nu = 6;
+    const int nv = 4;
+    TColgp_Array2OfPnt poles(1, nu, 1, nv);
+    TColStd_Array2OfReal weights(1, nu, 1, nv);
+    for (int i = 1; i <= nu; ++i) {
+        for (int j = 1; j <= nv; ++j) {
+            poles(i, j) = gp_Pnt(i, j, std::sin(i * j * 0.3));
+            weights(i, j) = 1. + 0.1 * ((i + j) % 3);
+        }
+    }
+    auto uknots = OccFArray({0., 0.3, 0.5, 1.});
+    auto umults = OccIArray({udegree + 1, 1, 1, udegree + 1});
+    auto vknots = OccFArray({0., 0.7, 1.});
+    auto vmults = OccIArray({vdegree + 1, 1, vdegree + 1});
+
+    Handle(Geom_BSplineSurface) surface = new Geom_BSplineSurface(poles, weights, uknots->Array1(), vknots->Array1(),
+                                                                  umults->Array1(), vmults->Array1(), udegree, vdegree);
+    ASSERT_TRUE(surface->IsURational() || surface->IsVRational());
+
+    std::vector<double> u, v;
+    for (int i = 0; i <= 10; ++i) {
+        u.push_back(i / 10.);
+    }
+    for (int j = 0; j <= 7; ++j) {
+        v.push_back(j / 7.);
+    }
+
+    geoml::BSplineSurfaceEvaluator evaluator(surface);
+
+    auto points = evaluator.EvaluateGrid(u, v);
+    EXPECT_EQ(11, points.nu);
+    EXPECT_EQ(8, points.nv);
+    EXPECT_EQ(88, points.x.size());
+    EXPECT_TRUE(points.du_x.empty());
+    EXPECT_TRUE(points.normal_x.empty());
+
+    auto grid = evaluator.EvaluateGrid(u, v, true, true);
+    for (size_t i = 0; i < u.size(); ++i) {
+        for (size_t j = 0; j < v.size(); ++j) {
+            const size_t idx = i * v.size() + j;
+
+            gp_Pnt p;
+            gp_Vec du, dv;
+            surface->D1(u[i], v[j], p, du, dv);
+            gp_Dir n(du.Crossed(dv));
+
+            EXPECT_NEAR(0., p.Distance(gp_Pnt(grid.x[idx], grid.y[idx], grid.z[idx])), 1e-10);
+            EXPECT_NEAR(0., p.Distance(gp_Pnt(points.x[idx], points.y[idx], points.z[idx])), 1e-10);
+            EXPECT_NEAR(0., (du - gp_Vec(grid.du_x[idx], grid.du_y[idx], grid.du_z[idx])).Magnitude(), 1e-9);
+            EXPECT_NEAR(0., (dv - gp_Vec(grid.dv_x[idx], grid.dv_y[idx], grid.dv_z[idx])).Magnitude(), 1e-9);
+            EXPECT_NEAR(0., (gp_Vec(n) - gp_Vec(grid.normal_x[idx], grid.normal_y[idx], grid.normal_z[idx])).Magnitude(), 1e-9);
+        }
+    }
+}
@@ -22,6 +22,10 @@
 #include <TColStd_HArray1OfReal.hxx>
 #include <TColStd_HArray1OfInteger.hxx>
 #include <TColgp_HArray1OfPnt.hxx>
+#include <Geom_Circle.hxx>
+#include <Geom_TrimmedCurve.hxx>
+#include <GeomConvert.hxx>
+#include <gp_Ax2.hxx>
 
 #include "IntersectBSplines.h"
 #include "common/CommonFunctions.h"
@@ -118,3 +122,29 @@ TEST(BSplineIntersection, ex2)
     results = geoml::IntersectBSplines(c1, c2, 0.07071);
     EXPECT_EQ(0, results.size());
 }
+
+TEST(BSplineIntersection, rational)
+{
+    // half circle with radius 1, converted into a rational B-spline
+    Handle(Geom_Circle) circle = new Geom_Circle(gp_Ax2(gp_Pnt(0., 0., 0.), gp_Dir(0., 0., 1.)), 1.);
+    Handle(Geom_TrimmedCurve) arc = new Geom_TrimmedCurve(circle, -M_PI/2., M_PI/2.);
+    Handle(Geom_BSplineCurve) c1 = GeomConvert::CurveToBSplineCurve(arc);
+    ASSERT_TRUE(c1->IsRational());
+
+    auto knots = OccFArray({0., 1.});
+    auto mults = OccIArray({2, 2});
+    auto cp = OccArray({
+        gp_Pnt(-2., 0.5, 0.),
+        gp_Pnt(2., 0.5, 0.)
+    });
+    Handle(Geom_BSplineCurve) c2 = new Geom_BSplineCurve(cp->Array1(), knots->Array1(), mults->Array1(), 1);
+
+    const double tolerance = 1e-5;
+    auto results = geoml::IntersectBSplines(c1, c2, tolerance);
+
+    ASSERT_EQ(1, results.size());
+    gp_Pnt p1 = c1->Value(results[0].parmOnCurve1);
+    gp_Pnt p2 = c2->Value(results[0].parmOnCurve2);
+    EXPECT_LE(p1.Distance(p2), tolerance);
+    EXPECT_NEAR(0.0, geoml::Point(std::sqrt(0.75), 0.5, 0.).distance2(results[0].point), 1e-8);
+}
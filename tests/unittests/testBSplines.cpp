@@ -33,6 +33,7 @@
 #include <BRep_Builder.hxx>
 #include <TopoDS_Compound.hxx>
 #include <geometry/BSplineAlgorithms.h>
+#include "geometry/BSplineBasisMatrix.h"
 #include <cmath>
 #include <math_Matrix.hxx>
 #include "geometry/BSplineFit.h"
@@ -140,6 +141,66 @@ TEST(BSplines, bSplineMatDeriv1)
     EXPECT_NEAR(A.Value(4,3), 2., 1e-10);
 }
 
+// tests the kernels of the sparse bspline basis matrix against dense products
+TEST(BSplines, bSplineMatSparse)
+{
+    // cubic spline with 6 control points
+    TColStd_Array1OfReal knots(1, 10);
+    double flatKnots[] = {0., 0., 0., 0., 0.3, 0.6, 1., 1., 1., 1.};
+    for (int i = 1; i <= 10; ++i) {
+        knots.SetValue(i, flatKnots[i-1]);
+    }
+
+    std::vector<double> params;
+    for (int i = 0; i <= 20; ++i) {
+        params.push_back(i / 20.);
+    }
+
+    geoml::BSplineBasisMatrix sparse(3, knots, params);
+    ASSERT_EQ(21, sparse.RowNumber());
+    ASSERT_EQ(6, sparse.ColNumber());
+    ASSERT_EQ(4, sparse.RowLength());
+
+    math_Matrix A = sparse.ToDense();
+    for (int i = 1; i <= A.RowNumber(); ++i) {
+        double rowSum = 0.;
+        for (int j = 1; j <= A.ColNumber(); ++j) {
+            EXPECT_EQ(A(i, j), sparse.Value(i, j));
+            rowSum += A(i, j);
+        }
+        // partition of unity
+        EXPECT_NEAR(1., rowSum, 1e-12);
+    }
+
+    math_Matrix AtA = A.Transposed() * A;
+    math_Matrix AtASparse = sparse.TransposedTimesSelf().ToDense();
+    for (int i = 1; i <= 6; ++i) {
+        for (int j = 1; j <= 6; ++j) {
+            EXPECT_NEAR(AtA(i, j), AtASparse(i, j), 1e-12);
+        }
+    }
+
+    math_Vector b(1, 21);
+    for (int i = 1; i <= 21; ++i) {
+        b(i) = std::sin(0.3 * i);
+    }
+    math_Vector Atb = A.Transposed() * b;
+    math_Vector AtbSparse = sparse.TransposedMultiplied(b);
+    for (int i = 1; i <= 6; ++i) {
+        EXPECT_NEAR(Atb(i), AtbSparse(i), 1e-12);
+    }
+
+    math_Vector x(1, 6);
+    for (int i = 1; i <= 6; ++i) {
+        x(i) = 1. + i * i;
+    }
+    math_Vector Ax = A * x;
+    math_Vector AxSparse = sparse.Multiplied(x);
+    for (int i = 1; i <= 21; ++i) {
+        EXPECT_NEAR(Ax(i), AxSparse(i), 1e-12);
+    }
+}
+
 class BSplineInterpolation : public ::testing::Test
 {
 protected:
@@ -202,6 +263,26 @@ TEST_F(BSplineInterpolation, approxAndInterpolate)
     StoreResult("TestData/analysis/BSplineInterpolation-approxAndInterpolate.brep", result.curve, pnts);
 }
 
+TEST_F(BSplineInterpolation, approxBandedSolverMatchesDense)
+{
+    geoml::BSplineApproxInterp app(pnts, 30, 3);
+    app.InterpolatePoint(0);
+    app.InterpolatePoint(50);
+    app.InterpolatePoint(100);
+
+    app.SetSolverType(geoml::BSplineApproxInterp::DenseSolver);
+    geoml::ApproxResult dense = app.FitCurve(parms);
+
+    app.SetSolverType(geoml::BSplineApproxInterp::BandedSolver);
+    geoml::ApproxResult banded = app.FitCurve(parms);
+
+    EXPECT_NEAR(dense.error, banded.error, 1e-10);
+    ASSERT_EQ(dense.curve->NbPoles(), banded.curve->NbPoles());
+    for (int i = 1; i <= dense.curve->NbPoles(); ++i) {
+        EXPECT_NEAR(0.0, dense.curve->Pole(i).Distance(banded.curve->Pole(i)), 1e-8);
+    }
+}
+
 // tests whether the approximation of a given unit circle is C2 continuous at the closing without interpolating any points
 TEST_F(BSplineInterpolation, approxAndInterpolateContinuous1)
 {
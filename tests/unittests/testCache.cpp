@@ -0,0 +1,240 @@
+/*
+* Copyright (C) 2026 German Aerospace Center (DLR/SC)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "test.h"
+
+#include <Cache.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+class Counter
+{
+public:
+    Counter()
+        : m_cache(*this, &Counter::build)
+    {
+    }
+
+    struct Result {
+        int value = 0;
+    };
+
+    void build(Result& result) const
+    {
+        if (fail) {
+            throw std::runtime_error("build failed");
+        }
+        result.value = ++nBuilds;
+    }
+
+    mutable int nBuilds = 0;
+    bool fail = false;
+    geoml::Cache<Result, Counter> m_cache;
+};
+
+// counts the living instances of its cached state
+class Tracker
+{
+public:
+    Tracker()
+        : m_cache(*this, &Tracker::build)
+    {
+    }
+
+    struct State {
+        State() { ++nAlive; }
+        State(const State& other) : value(other.value) { ++nAlive; }
+        State& operator=(const State&) = default;
+        ~State() { --nAlive; }
+
+        int value = 0;
+    };
+
+    void build(State& state) const
+    {
+        state.value = 1;
+    }
+
+    static int nAlive;
+    geoml::Cache<State, Tracker> m_cache;
+};
+
+int Tracker::nAlive = 0;
+
+} // namespace
+
+TEST(Cache, buildOnce)
+{
+    Counter counter;
+    EXPECT_EQ(1, counter.m_cache->value);
+    EXPECT_EQ(1, counter.m_cache->value);
+    EXPECT_EQ(1, counter.nBuilds);
+    EXPECT_EQ(1u, counter.m_cache.misses());
+    EXPECT_EQ(1u, counter.m_cache.hits());
+}
+
+TEST(Cache, invalidate)
+{
+    Counter counter;
+    const Counter::Result& old = counter.m_cache.value();
+    EXPECT_EQ(1, old.value);
+
+    counter.m_cache.invalidate();
+    EXPECT_EQ(1u, counter.m_cache.epoch());
+
+    // the cache is rebuilt, but the old reference is still valid
+    EXPECT_EQ(2, counter.m_cache->value);
+    EXPECT_EQ(1, old.value);
+    EXPECT_EQ(2u, counter.m_cache.misses());
+
+    counter.m_cache.clear();
+    EXPECT_EQ(3, counter.m_cache->value);
+}
+
+TEST(Cache, buildFailure)
+{
+    Counter counter;
+    counter.fail = true;
+    EXPECT_THROW(counter.m_cache.value(), std::runtime_error);
+
+    counter.fail = false;
+    EXPECT_EQ(1, counter.m_cache->value);
+}
+
+TEST(Cache, concurrentReads)
+{
+    Counter counter;
+
+    std::vector<std::thread> threads;
+    std::vector<int> values(8, 0);
+    for (size_t i = 0; i < values.size(); ++i) {
+        threads.emplace_back([&counter, &values, i]() {
+            for (int k = 0; k < 1000; ++k) {
+                values[i] = counter.m_cache->value;
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(1, counter.nBuilds);
+    for (int value : values) {
+        EXPECT_EQ(1, value);
+    }
+    EXPECT_EQ(8000u, counter.m_cache.hits() + counter.m_cache.misses());
+}
+
+TEST(Cache, outdatedStatesAreReleased)
+{
+    {
+        Tracker tracker;
+        for (int i = 0; i < 100; ++i) {
+            tracker.m_cache.invalidate();
+            EXPECT_EQ(1, tracker.m_cache->value);
+        }
+        // the outdated states are not referenced anymore
+        EXPECT_EQ(1, Tracker::nAlive);
+
+        // a snapshot keeps its state alive, even after clearing the cache
+        auto snapshot = tracker.m_cache.snapshot();
+        tracker.m_cache.invalidate();
+        EXPECT_EQ(1, tracker.m_cache->value);
+        tracker.m_cache.clear();
+        EXPECT_EQ(1, snapshot->value);
+        EXPECT_EQ(1, Tracker::nAlive);
+    }
+    EXPECT_EQ(0, Tracker::nAlive);
+}
+
+TEST(Cache, referencedStatesAreKeptUntilClear)
+{
+    {
+        Tracker tracker;
+        std::vector<const Tracker::State*> states;
+        for (int i = 0; i < 10; ++i) {
+            tracker.m_cache.invalidate();
+            states.push_back(&tracker.m_cache.value());
+        }
+        // all references obtained by value() are still valid
+        EXPECT_EQ(10, Tracker::nAlive);
+        for (auto state : states) {
+            EXPECT_EQ(1, state->value);
+        }
+
+        tracker.m_cache.clear();
+        EXPECT_EQ(0, Tracker::nAlive);
+    }
+    EXPECT_EQ(0, Tracker::nAlive);
+}
+
+TEST(Cache, concurrentRebuilds)
+{
+    Counter counter;
+
+    // readers keep using their references, while the cache is rebuilt
+    std::atomic<bool> done{false};
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; ++i) {
+        readers.emplace_back([&counter, &done]() {
+            while (!done.load()) {
+                const Counter::Result& result = counter.m_cache.value();
+                auto snapshot = counter.m_cache.snapshot();
+                EXPECT_GT(result.value, 0);
+                EXPECT_GT(snapshot->value, 0);
+            }
+        });
+    }
+    for (int i = 0; i < 1000; ++i) {
+        counter.m_cache.invalidate();
+    }
+    done.store(true);
+    for (auto& reader : readers) {
+        reader.join();
+    }
+}
+
+TEST(Cache, writeAccessPublishesOnRelease)
+{
+    Counter counter;
+    EXPECT_EQ(1, counter.m_cache->value);
+
+    {
+        auto ref = counter.m_cache.writeAccess();
+        EXPECT_EQ(1, ref->value);
+        ref->value = 42;
+        // readers still see the previous state while it is written
+        EXPECT_EQ(1, counter.m_cache->value);
+    }
+    EXPECT_EQ(42, counter.m_cache->value);
+    EXPECT_EQ(1, counter.nBuilds);
+
+    // writing into an empty cache does not call the build function
+    Counter empty;
+    {
+        auto ref = empty.m_cache.writeAccess();
+        EXPECT_EQ(0, ref->value);
+        ref->value = 7;
+    }
+    EXPECT_EQ(7, empty.m_cache->value);
+    EXPECT_EQ(0, empty.nBuilds);
+}
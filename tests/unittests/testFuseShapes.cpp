@@ -0,0 +1,110 @@
+/*
+* Copyright (C) 2026 German Aerospace Center (DLR/SC)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "test.h"
+
+#include "boolean_operations/CFuseShapes.h"
+#include "CNamedShape.h"
+
+#include <BRepAdaptor_Curve.hxx>
+#include <BRepClass3d_SolidClassifier.hxx>
+#include <BRepPrimAPI_MakeBox.hxx>
+#include <BRepGProp.hxx>
+#include <GProp_GProps.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopoDS.hxx>
+
+#include <string>
+
+namespace
+{
+
+PNamedShape box(const gp_Pnt& p, double dx, double dy, double dz, const std::string& name)
+{
+    PNamedShape shape(new CNamedShape(BRepPrimAPI_MakeBox(p, dx, dy, dz).Shape(), name));
+    shape->SetShortName(name);
+    return shape;
+}
+
+double volume(const TopoDS_Shape& shape)
+{
+    GProp_GProps props;
+    BRepGProp::VolumeProperties(shape, props);
+    return props.Mass();
+}
+
+} // namespace
+
+TEST(CFuseShapes, multipleChilds)
+{
+    PNamedShape parent = box(gp_Pnt(0., 0., 0.), 10., 1., 1., "P");
+
+    // disjoint childs attached on top of the parent
+    ListPNamedShape childs;
+    for (int i = 0; i < 4; ++i) {
+        childs.push_back(box(gp_Pnt(2. * i + 0.5, 0.25, 0.5), 1., 0.5, 1., "C" + std::to_string(i)));
+    }
+
+    CFuseShapes fuser(parent, childs);
+    PNamedShape result = fuser.NamedShape();
+    ASSERT_TRUE(!!result);
+    EXPECT_NEAR(10. + 4 * 0.25, volume(result->Shape()), 1e-6);
+
+    // the results are in the order of the childs
+    const ListPNamedShape& intersections = fuser.Intersections();
+    ASSERT_EQ(4, intersections.size());
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_EQ("INTPC" + std::to_string(i), intersections[i]->Name());
+        EXPECT_FALSE(intersections[i]->Shape().IsNull());
+    }
+    ASSERT_EQ(4, fuser.TrimmedChilds().size());
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_EQ("C" + std::to_string(i), fuser.TrimmedChilds()[i]->Name());
+    }
+}
+
+TEST(CFuseShapes, overlappingChilds)
+{
+    PNamedShape parent = box(gp_Pnt(0., 0., 0.), 10., 1., 1., "P");
+
+    // two overlapping childs on top of the parent
+    ListPNamedShape childs;
+    childs.push_back(box(gp_Pnt(2., 0.25, 0.5), 2., 0.5, 1., "C0"));
+    childs.push_back(box(gp_Pnt(3., 0.25, 0.5), 2., 0.5, 1., "C1"));
+
+    CFuseShapes fuser(parent, childs);
+    PNamedShape result = fuser.NamedShape();
+    ASSERT_TRUE(!!result);
+    EXPECT_NEAR(10. + 3. * 0.25, volume(result->Shape()), 1e-6);
+
+    // the intersection of a child with the parent must not contain curves inside of the other child
+    const ListPNamedShape& intersections = fuser.Intersections();
+    ASSERT_EQ(2, intersections.size());
+    for (int i = 0; i < 2; ++i) {
+        const TopoDS_Shape& other = childs[1 - i]->Shape();
+
+        int nEdges = 0;
+        for (TopExp_Explorer explorer(intersections[i]->Shape(), TopAbs_EDGE); explorer.More(); explorer.Next()) {
+            BRepAdaptor_Curve curve(TopoDS::Edge(explorer.Current()));
+            gp_Pnt midpoint = curve.Value(0.5 * (curve.FirstParameter() + curve.LastParameter()));
+
+            BRepClass3d_SolidClassifier classifier(other, midpoint, 1e-6);
+            EXPECT_NE(TopAbs_IN, classifier.State());
+            nEdges++;
+        }
+        EXPECT_GT(nEdges, 0);
+    }
+}
@@ -0,0 +1,164 @@
+/*
+* Copyright (C) 2026 German Aerospace Center (DLR/SC)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "test.h"
+
+#include "boolean_operations/CIntersectionContext.h"
+#include "boolean_operations/CFuseShapes.h"
+#include "boolean_operations/CTrimShape.h"
+#include "CNamedShape.h"
+#include "common/CommonFunctions.h"
+
+#include <BRepPrimAPI_MakeBox.hxx>
+#include <TopExp.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+
+namespace
+{
+
+class IntersectionContext : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        previousMaxEntries = CIntersectionContextCache::Instance().MaxEntries();
+        CIntersectionContextCache::Instance().SetMaxEntries(8);
+        CIntersectionContextCache::Instance().Clear();
+        box1 = BRepPrimAPI_MakeBox(gp_Pnt(0., 0., 0.), 1., 1., 1.).Shape();
+        box2 = BRepPrimAPI_MakeBox(gp_Pnt(0.5, 0.25, 0.25), 1., 0.5, 0.5).Shape();
+    }
+
+    void TearDown() override
+    {
+        CIntersectionContextCache::Instance().Clear();
+        CIntersectionContextCache::Instance().SetMaxEntries(previousMaxEntries);
+    }
+
+    size_t previousMaxEntries = 0;
+    TopoDS_Shape box1, box2;
+};
+
+} // namespace
+
+TEST_F(IntersectionContext, disabledByDefault)
+{
+    EXPECT_EQ(0, previousMaxEntries);
+}
+
+TEST_F(IntersectionContext, cached)
+{
+    PIntersectionContext context = CIntersectionContext::Get(box1, box2);
+    ASSERT_TRUE(!!context);
+    EXPECT_FALSE(context->HasErrors());
+    EXPECT_EQ(1, CIntersectionContextCache::Instance().Size());
+
+    // the order of the arguments does not matter
+    EXPECT_EQ(context, CIntersectionContext::Get(box2, box1));
+
+    // different options or orientations result in a new intersection
+    CIntersectionContext::Options options;
+    options.fuzzyValue = 1e-5;
+    EXPECT_NE(context, CIntersectionContext::Get(box1, box2, options));
+    EXPECT_NE(context, CIntersectionContext::Get(box1, box2.Reversed()));
+    EXPECT_EQ(3, CIntersectionContextCache::Instance().Size());
+
+    // the parallel mode does not change the intersection
+    options = CIntersectionContext::Options();
+    options.runParallel = true;
+    EXPECT_EQ(context, CIntersectionContext::Get(box1, box2, options));
+}
+
+TEST_F(IntersectionContext, maxEntries)
+{
+    CIntersectionContextCache& cache = CIntersectionContextCache::Instance();
+    size_t maxEntries = cache.MaxEntries();
+
+    cache.SetMaxEntries(1);
+    PIntersectionContext context = CIntersectionContext::Get(box1, box2);
+    CIntersectionContext::Get(box1, box2.Reversed());
+    EXPECT_EQ(1, cache.Size());
+    EXPECT_NE(context, CIntersectionContext::Get(box1, box2));
+
+    cache.SetMaxEntries(0);
+    EXPECT_EQ(0, cache.Size());
+    EXPECT_NE(CIntersectionContext::Get(box1, box2), CIntersectionContext::Get(box1, box2));
+
+    cache.SetMaxEntries(maxEntries);
+}
+
+TEST_F(IntersectionContext, sharedByOperations)
+{
+    PNamedShape parent(new CNamedShape(box1, "parent"));
+    PNamedShape child(new CNamedShape(box2, "child"));
+
+    PNamedShape trimmed = CTrimShape(child, parent, EXCLUDE);
+    ASSERT_TRUE(!!trimmed);
+    EXPECT_EQ(1, CIntersectionContextCache::Instance().Size());
+
+    // the split uses a fuzzy intersection, which is reused by the next split
+    TopoDS_Shape split = SplitShape(box2, box1);
+    EXPECT_FALSE(split.IsNull());
+    EXPECT_EQ(2, CIntersectionContextCache::Instance().Size());
+    SplitShape(box1, box2);
+    EXPECT_EQ(2, CIntersectionContextCache::Instance().Size());
+
+    // trimming with an explicit context gives the same result
+    PNamedShape trimmed2 = CTrimShape(child, parent, CIntersectionContext::Get(box1, box2), EXCLUDE);
+    TopTools_IndexedMapOfShape faces1, faces2;
+    TopExp::MapShapes(trimmed->Shape(), TopAbs_FACE, faces1);
+    TopExp::MapShapes(trimmed2->Shape(), TopAbs_FACE, faces2);
+    EXPECT_EQ(faces1.Extent(), faces2.Extent());
+
+    PNamedShape fused = CFuseShapes(parent, ListPNamedShape{child});
+    ASSERT_TRUE(!!fused);
+    EXPECT_FALSE(fused->Shape().IsNull());
+}
+
+TEST_F(IntersectionContext, fuseThenTrim)
+{
+    size_t computed = CIntersectionContext::NumComputed();
+
+    PNamedShape parent(new CNamedShape(box1, "parent"));
+    PNamedShape child(new CNamedShape(box2, "child"));
+
+    // the section and both trims of the fuse use a single intersection,
+    // which is reused by the trim
+    PNamedShape fused = CFuseShapes(parent, ListPNamedShape{child});
+    ASSERT_TRUE(!!fused);
+    EXPECT_EQ(computed + 1, CIntersectionContext::NumComputed());
+
+    PNamedShape trimmed = CTrimShape(child, parent, EXCLUDE);
+    ASSERT_TRUE(!!trimmed);
+    EXPECT_EQ(computed + 1, CIntersectionContext::NumComputed());
+    EXPECT_EQ(1, CIntersectionContextCache::Instance().Size());
+}
+
+TEST_F(IntersectionContext, fuseMultipleChilds)
+{
+    size_t computed = CIntersectionContext::NumComputed();
+
+    PNamedShape parent(new CNamedShape(box1, "parent"));
+    ListPNamedShape childs;
+    childs.push_back(PNamedShape(new CNamedShape(BRepPrimAPI_MakeBox(gp_Pnt(0.25, 0.25, 0.5), 0.25, 0.25, 1.).Shape(), "child1")));
+    childs.push_back(PNamedShape(new CNamedShape(BRepPrimAPI_MakeBox(gp_Pnt(0.6, 0.6, 0.5), 0.25, 0.25, 1.).Shape(), "child2")));
+
+    // a private intersection per child and a single one to trim the parent,
+    // the childs do not overlap, hence their intersections are not clipped
+    PNamedShape fused = CFuseShapes(parent, childs);
+    ASSERT_TRUE(!!fused);
+    EXPECT_EQ(computed + childs.size() + 1, CIntersectionContext::NumComputed());
+    EXPECT_EQ(1, CIntersectionContextCache::Instance().Size());
+}
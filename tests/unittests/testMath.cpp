@@ -24,6 +24,8 @@
 #include "geometry/Transformation.h"
 
 #include "math/Matrix.h"
+#include "math/BandedMatrix.h"
+#include "geoml/error.h"
 
 #include <cstdlib>
 
@@ -476,3 +478,77 @@ TEST(Math, matrixIO)
         }
     }
 }
+
+TEST(Math, SymmetricBandedCholesky)
+{
+    // tridiagonal, diagonally dominant matrix
+    const int n = 6;
+    geoml::SymmetricBandedMatrix A(n, 1);
+    for (int i = 1; i <= n; ++i) {
+        A(i, i) = 4.;
+        if (i > 1) {
+            A(i, i-1) = -1.;
+        }
+    }
+
+    EXPECT_EQ(-1., A(1, 2));
+    EXPECT_EQ(0., A(1, 3));
+
+    math_Matrix dense = A.ToDense();
+    math_Vector x_ref(1, n);
+    for (int i = 1; i <= n; ++i) {
+        x_ref(i) = static_cast<double>(i);
+    }
+    math_Vector b = dense * x_ref;
+
+    ASSERT_TRUE(A.Factorize());
+    A.Solve(b);
+    for (int i = 1; i <= n; ++i) {
+        EXPECT_NEAR(x_ref(i), b(i), 1e-12);
+    }
+
+    // singular matrix
+    geoml::SymmetricBandedMatrix S(3, 1);
+    S(1, 1) = 1.;
+    S(2, 1) = 1.;
+    S(2, 2) = 1.;
+    S(3, 3) = 1.;
+    EXPECT_FALSE(S.Factorize());
+
+    // invalid sizes are rejected before allocating
+    EXPECT_THROW(geoml::SymmetricBandedMatrix(0, 1), geoml::Error);
+    EXPECT_THROW(geoml::SymmetricBandedMatrix(-5, 2), geoml::Error);
+}
+
+TEST(Math, SymmetricBandedCholeskyMultipleRhs)
+{
+    // pentadiagonal, diagonally dominant matrix
+    const int n = 7;
+    geoml::SymmetricBandedMatrix A(n, 2);
+    for (int i = 1; i <= n; ++i) {
+        A(i, i) = 6.;
+        if (i > 1) {
+            A(i, i-1) = -1.5;
+        }
+        if (i > 2) {
+            A(i, i-2) = 0.5;
+        }
+    }
+
+    math_Matrix dense = A.ToDense();
+    math_Matrix X_ref(1, n, 1, 3);
+    for (int i = 1; i <= n; ++i) {
+        X_ref(i, 1) = static_cast<double>(i);
+        X_ref(i, 2) = 1. / static_cast<double>(i);
+        X_ref(i, 3) = -2. * i * i;
+    }
+    math_Matrix B = dense * X_ref;
+
+    ASSERT_TRUE(A.Factorize());
+    A.Solve(B);
+    for (int i = 1; i <= n; ++i) {
+        for (int c = 1; c <= 3; ++c) {
+            EXPECT_NEAR(X_ref(i, c), B(i, c), 1e-11);
+        }
+    }
+}
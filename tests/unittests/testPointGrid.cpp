@@ -0,0 +1,62 @@
+/*
+* Copyright (C) 2026 German Aerospace Center (DLR/SC)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "test.h"
+
+#include "geometry/PointGrid.h"
+#include "geoml/error.h"
+
+#include <random>
+#include <vector>
+
+TEST(PointGrid, bruteForce)
+{
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> coordinate(-10., 10.);
+
+    std::vector<gp_Pnt> points;
+    for (int i = 0; i < 2000; ++i) {
+        points.emplace_back(coordinate(generator), coordinate(generator), coordinate(generator));
+    }
+
+    for (double radius : {0.5, 1., 2.5}) {
+        geoml::PointGrid grid(points, 1.);
+        for (int i = 0; i < 100; ++i) {
+            gp_Pnt p(coordinate(generator), coordinate(generator), coordinate(generator));
+
+            std::vector<size_t> expected;
+            for (size_t j = 0; j < points.size(); ++j) {
+                if (points[j].SquareDistance(p) < radius * radius) {
+                    expected.push_back(j);
+                }
+            }
+            EXPECT_EQ(expected, grid.Neighbors(p, radius));
+        }
+    }
+}
+
+TEST(PointGrid, coincidentPoints)
+{
+    std::vector<gp_Pnt> points = {gp_Pnt(0., 0., 0.), gp_Pnt(1e-5, 0., 0.), gp_Pnt(-1e-5, 0., 0.), gp_Pnt(1., 0., 0.)};
+    geoml::PointGrid grid(points, 1e-3);
+
+    // the points are on different sides of a cell boundary
+    EXPECT_EQ(std::vector<size_t>({0, 1, 2}), grid.Neighbors(gp_Pnt(0., 0., 0.), 1e-3));
+    EXPECT_EQ(std::vector<size_t>({3}), grid.Neighbors(gp_Pnt(1., 0., 0.), 1e-3));
+    EXPECT_TRUE(grid.Neighbors(gp_Pnt(0.5, 0., 0.), 1e-3).empty());
+
+    EXPECT_THROW(geoml::PointGrid(points, 0.), geoml::Error);
+}
@@ -0,0 +1,186 @@
+/*
+* Copyright (C) 2026 German Aerospace Center (DLR/SC)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "test.h"
+
+#include "geometry/SurfaceCache.h"
+#include "geoml/surfaces/surfaces.h"
+#include "common/CommonFunctions.h"
+
+#include <Geom_BSplineCurve.hxx>
+#include <Geom_BSplineSurface.hxx>
+#include <TColgp_Array2OfPnt.hxx>
+#include <TColStd_Array2OfReal.hxx>
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <sstream>
+#include <string>
+
+namespace
+{
+
+Handle(Geom_Curve) line(const gp_Pnt& p1, const gp_Pnt& p2)
+{
+    auto poles = OccArray({p1, p2});
+    auto knots = OccFArray({0., 1.});
+    auto mults = OccIArray({2, 2});
+    return new Geom_BSplineCurve(poles->Array1(), knots->Array1(), mults->Array1(), 1);
+}
+
+std::vector<Handle(Geom_Curve)> sections(double z)
+{
+    return {line(gp_Pnt(0., 0., 0.), gp_Pnt(1., 0., 0.)),
+            line(gp_Pnt(0., 1., z), gp_Pnt(1., 1., z)),
+            line(gp_Pnt(0., 2., 0.), gp_Pnt(1., 2., 0.))};
+}
+
+Handle(Geom_BSplineSurface) rationalSurface()
+{
+    TColgp_Array2OfPnt poles(1, 3, 1, 2);
+    TColStd_Array2OfReal weights(1, 3, 1, 2);
+    for (int i = 1; i <= 3; ++i) {
+        for (int j = 1; j <= 2; ++j) {
+            poles(i, j) = gp_Pnt(i, j, i * j);
+            weights(i, j) = 1. + 0.5 * (i == 2);
+        }
+    }
+    auto uknots = OccFArray({0., 1.});
+    auto umults = OccIArray({3, 3});
+    auto vknots = OccFArray({0., 1.});
+    auto vmults = OccIArray({2, 2});
+    return new Geom_BSplineSurface(poles, weights, uknots->Array1(), vknots->Array1(),
+                                   umults->Array1(), vmults->Array1(), 2, 1);
+}
+
+class SurfaceCacheTest : public ::testing::Test
+{
+protected:
+    void TearDown() override
+    {
+        geoml::SurfaceCache::Instance().Disable();
+    }
+};
+
+} // namespace
+
+TEST(SurfaceCacheKey, content)
+{
+    auto key1 = geoml::SurfaceCacheKey("test").Add(sections(1.)).Add(1e-4).Str();
+    auto key2 = geoml::SurfaceCacheKey("test").Add(sections(1.)).Add(1e-4).Str();
+    EXPECT_EQ(key1, key2);
+    EXPECT_EQ(32, key1.size());
+
+    EXPECT_NE(key1, geoml::SurfaceCacheKey("test").Add(sections(1.1)).Add(1e-4).Str());
+    EXPECT_NE(key1, geoml::SurfaceCacheKey("test").Add(sections(1.)).Add(2e-4).Str());
+    EXPECT_NE(key1, geoml::SurfaceCacheKey("other").Add(sections(1.)).Add(1e-4).Str());
+
+    EXPECT_EQ(geoml::SurfaceCacheKey("test").Add(0.).Str(), geoml::SurfaceCacheKey("test").Add(-0.).Str());
+}
+
+TEST(SurfaceCache, binaryFormat)
+{
+    Handle(Geom_BSplineSurface) surface = rationalSurface();
+
+    std::stringstream stream;
+    geoml::WriteBinarySurface(surface, stream);
+    Handle(Geom_BSplineSurface) result = geoml::ReadBinarySurface(stream);
+
+    ASSERT_FALSE(result.IsNull());
+    EXPECT_EQ(surface->UDegree(), result->UDegree());
+    EXPECT_EQ(surface->VDegree(), result->VDegree());
+    EXPECT_TRUE(result->IsURational());
+    for (int i = 0; i <= 10; ++i) {
+        EXPECT_NEAR(0., surface->Value(i / 10., 0.3).Distance(result->Value(i / 10., 0.3)), 1e-14);
+    }
+
+    std::stringstream invalid("not a surface");
+    EXPECT_TRUE(geoml::ReadBinarySurface(invalid).IsNull());
+
+    // a truncated file
+    const std::string data = stream.str();
+    std::stringstream truncated(data.substr(0, data.size() / 2));
+    EXPECT_TRUE(geoml::ReadBinarySurface(truncated).IsNull());
+
+    // huge pole counts must not be allocated. The counts start after the magic
+    // number, the version, the degrees and the periodic/rational flags.
+    std::string corrupt = data;
+    const size_t nPolesOffset = 8 + 4 + 2 * 4 + 3 + 2 * 4;
+    const int32_t hugeCount = 0x7fffffff;
+    std::memcpy(&corrupt[nPolesOffset], &hugeCount, sizeof(hugeCount));
+    std::memcpy(&corrupt[nPolesOffset + sizeof(hugeCount)], &hugeCount, sizeof(hugeCount));
+    std::stringstream corruptStream(corrupt);
+    EXPECT_TRUE(geoml::ReadBinarySurface(corruptStream).IsNull());
+}
+
+TEST_F(SurfaceCacheTest, memory)
+{
+    geoml::SurfaceCache& cache = geoml::SurfaceCache::Instance();
+    cache.Enable(2);
+
+    Handle(Geom_BSplineSurface) surface1 = geoml::interpolate_curves(sections(1.));
+    EXPECT_EQ(1, cache.Size());
+
+    // a cache hit returns an equal copy
+    Handle(Geom_BSplineSurface) surface2 = geoml::interpolate_curves(sections(1.));
+    EXPECT_EQ(1, cache.Size());
+    EXPECT_NE(surface1.get(), surface2.get());
+    EXPECT_NEAR(0., surface1->Value(0.5, 0.5).Distance(surface2->Value(0.5, 0.5)), 1e-14);
+
+    // least recently used entries are removed
+    geoml::interpolate_curves(sections(2.));
+    geoml::interpolate_curves(sections(3.));
+    EXPECT_EQ(2, cache.Size());
+
+    int nComputed = 0;
+    cache.GetOrCompute(geoml::SurfaceCacheKey("test"), [&]() {
+        nComputed++;
+        return rationalSurface();
+    });
+    cache.GetOrCompute(geoml::SurfaceCacheKey("test"), [&]() {
+        nComputed++;
+        return rationalSurface();
+    });
+    EXPECT_EQ(1, nComputed);
+
+    cache.Clear();
+    EXPECT_EQ(0, cache.Size());
+}
+
+TEST_F(SurfaceCacheTest, disk)
+{
+    std::string directory = "TestData/export/surface_cache";
+    std::filesystem::remove_all(directory);
+
+    geoml::SurfaceCache& cache = geoml::SurfaceCache::Instance();
+    cache.Enable(10, directory);
+
+    Handle(Geom_BSplineSurface) surface = geoml::interpolate_curves(sections(1.));
+    EXPECT_FALSE(std::filesystem::is_empty(directory));
+
+    // the surface must be read from disk after clearing the memory
+    cache.Clear();
+    int nComputed = 0;
+    std::string key = geoml::SurfaceCacheKey("interpolate_curves").Add(sections(1.)).Add(3u).Add(false).Str();
+    Handle(Geom_BSplineSurface) result = cache.GetOrCompute(geoml::SurfaceCacheKey("interpolate_curves").Add(sections(1.)).Add(3u).Add(false), [&]() {
+        nComputed++;
+        return surface;
+    });
+    EXPECT_EQ(0, nComputed);
+    EXPECT_TRUE(std::filesystem::exists(directory + "/" + key + ".bsurf"));
+    EXPECT_NEAR(0., surface->Value(0.3, 0.7).Distance(result->Value(0.3, 0.7)), 1e-14);
+}
@@ -37,6 +37,10 @@
 #include <TopExp.hxx>
 #include <TopTools_IndexedMapOfShape.hxx>
 #include <GeomConvert.hxx>
+#include <gp_Ax2.hxx>
+#include <Geom_Circle.hxx>
+#include <Geom_TrimmedCurve.hxx>
+#include <TColgp_HArray2OfPnt.hxx>
 
 Handle(Geom_BSplineCurve) createBSpline(const std::vector<gp_Pnt>& poles, const std::vector<double>& knots, int degree)
 {
@@ -831,6 +835,170 @@ TEST(BSplineAlgorithms, testInterpolatingSurface)
     }
 }
 
+namespace
+{
+
+// The surface interpolation as before the columns shared the factorization of
+// the interpolation system: each column is interpolated by its own PointsToBSplineInterpolation
+Handle(Geom_BSplineSurface) skinPerColumn(const std::vector<Handle(Geom_BSplineCurve)>& curves, const std::vector<double>& vParams, bool continuousIfClosed)
+{
+    double tolerance = BSplineAlgorithms::scale(curves) * BSplineAlgorithms::REL_TOL_CLOSED;
+    bool makeClosed = continuousIfClosed && curves.front()->IsEqual(curves.back(), tolerance);
+
+    std::vector<Handle(Geom_BSplineCurve)> compatible = BSplineAlgorithms::createCommonKnotsVectorCurve(curves, 1e-14);
+    const Handle(Geom_BSplineCurve)& firstCurve = compatible.front();
+
+    Handle(TColgp_HArray2OfPnt) cpSurf;
+    Handle(Geom_BSplineCurve) firstColumn;
+    for (int cpUIdx = 1; cpUIdx <= firstCurve->NbPoles(); ++cpUIdx) {
+        Handle(TColgp_HArray1OfPnt) column = new TColgp_HArray1OfPnt(1, static_cast<int>(compatible.size()));
+        for (int cpVIdx = 1; cpVIdx <= static_cast<int>(compatible.size()); ++cpVIdx) {
+            column->SetValue(cpVIdx, compatible[cpVIdx - 1]->Pole(cpUIdx));
+        }
+
+        Handle(Geom_BSplineCurve) interpSpline = PointsToBSplineInterpolation(column, vParams, 3, makeClosed).Curve();
+        if (makeClosed && interpSpline->IsPeriodic()) {
+            interpSpline->SetNotPeriodic();
+            interpSpline = GeomConvert::CurveToBSplineCurve(new Geom_TrimmedCurve(interpSpline, interpSpline->FirstParameter(), interpSpline->LastParameter()));
+        }
+
+        if (cpUIdx == 1) {
+            firstColumn = interpSpline;
+            cpSurf = new TColgp_HArray2OfPnt(1, firstCurve->NbPoles(), 1, interpSpline->NbPoles());
+        }
+        for (int i = 1; i <= interpSpline->NbPoles(); ++i) {
+            cpSurf->SetValue(cpUIdx, i, interpSpline->Pole(i));
+        }
+    }
+
+    TColStd_Array1OfReal knotsU(1, firstCurve->NbKnots());
+    firstCurve->Knots(knotsU);
+    TColStd_Array1OfInteger multsU(1, firstCurve->NbKnots());
+    firstCurve->Multiplicities(multsU);
+    TColStd_Array1OfReal knotsV(1, firstColumn->NbKnots());
+    firstColumn->Knots(knotsV);
+    TColStd_Array1OfInteger multsV(1, firstColumn->NbKnots());
+    firstColumn->Multiplicities(multsV);
+
+    return new Geom_BSplineSurface(cpSurf->Array2(), knotsU, knotsV, multsU, multsV, firstCurve->Degree(), firstColumn->Degree());
+}
+
+Handle(Geom_BSplineSurface) pointsToSurfacePerColumn(const TColgp_Array2OfPnt& points, const std::vector<double>& uParams, const std::vector<double>& vParams)
+{
+    double tolerance = BSplineAlgorithms::REL_TOL_CLOSED * BSplineAlgorithms::scale(points);
+    bool makeUDirClosed = BSplineAlgorithms::isUDirClosed(points, tolerance);
+    bool makeVDirClosed = BSplineAlgorithms::isVDirClosed(points, tolerance);
+
+    std::vector<Handle(Geom_BSplineCurve)> uSplines;
+    for (int cpVIdx = points.LowerCol(); cpVIdx <= points.UpperCol(); ++cpVIdx) {
+        Handle(TColgp_HArray1OfPnt) column = new TColgp_HArray1OfPnt(points.LowerRow(), points.UpperRow());
+        for (int cpUIdx = points.LowerRow(); cpUIdx <= points.UpperRow(); ++cpUIdx) {
+            column->SetValue(cpUIdx, points(cpUIdx, cpVIdx));
+        }
+        uSplines.push_back(PointsToBSplineInterpolation(column, uParams, 3, makeUDirClosed).Curve());
+    }
+    return skinPerColumn(uSplines, vParams, makeVDirClosed);
+}
+
+void expectSamePoles(const Handle(Geom_BSplineSurface)& expected, const Handle(Geom_BSplineSurface)& actual, double tolerance)
+{
+    ASSERT_EQ(expected->UDegree(), actual->UDegree());
+    ASSERT_EQ(expected->VDegree(), actual->VDegree());
+    ASSERT_EQ(expected->NbUPoles(), actual->NbUPoles());
+    ASSERT_EQ(expected->NbVPoles(), actual->NbVPoles());
+    ASSERT_EQ(expected->NbUKnots(), actual->NbUKnots());
+    ASSERT_EQ(expected->NbVKnots(), actual->NbVKnots());
+    EXPECT_EQ(expected->IsUPeriodic(), actual->IsUPeriodic());
+    EXPECT_EQ(expected->IsVPeriodic(), actual->IsVPeriodic());
+
+    for (int i = 1; i <= expected->NbUKnots(); ++i) {
+        EXPECT_NEAR(expected->UKnot(i), actual->UKnot(i), 1e-14);
+        EXPECT_EQ(expected->UMultiplicity(i), actual->UMultiplicity(i));
+    }
+    for (int i = 1; i <= expected->NbVKnots(); ++i) {
+        EXPECT_NEAR(expected->VKnot(i), actual->VKnot(i), 1e-14);
+        EXPECT_EQ(expected->VMultiplicity(i), actual->VMultiplicity(i));
+    }
+    for (int i = 1; i <= expected->NbUPoles(); ++i) {
+        for (int j = 1; j <= expected->NbVPoles(); ++j) {
+            EXPECT_LT(expected->Pole(i, j).Distance(actual->Pole(i, j)), tolerance) << "pole (" << i << ", " << j << ")";
+        }
+    }
+}
+
+} // namespace
+
+TEST(BSplineAlgorithms, pointsToSurfaceMatchesPerColumnInterpolation)
+{
+    // open grid on a doubly curved surface
+    TColgp_Array2OfPnt points(1, 12, 1, 9);
+    for (int i = 1; i <= 12; ++i) {
+        for (int j = 1; j <= 9; ++j) {
+            double x = (i - 1) / 11.;
+            double y = (j - 1) / 8.;
+            points(i, j) = gp_Pnt(x, y, std::sin(3. * x) * std::cos(2. * y) + 0.1 * x * y);
+        }
+    }
+
+    auto params = BSplineAlgorithms::computeParamsBSplineSurf(points);
+    auto expected = pointsToSurfacePerColumn(points, params.first, params.second);
+    auto actual = BSplineAlgorithms::pointsToSurface(points, params.first, params.second, true, true);
+    expectSamePoles(expected, actual, 1e-10);
+}
+
+TEST(BSplineAlgorithms, pointsToSurfaceMatchesPerColumnInterpolationClosed)
+{
+    // torus grid, which is closed in both directions
+    const int nu = 13, nv = 10;
+    const double R = 3., r = 1.;
+    TColgp_Array2OfPnt points(1, nu, 1, nv);
+    for (int i = 1; i <= nu; ++i) {
+        for (int j = 1; j <= nv; ++j) {
+            double phi = 2. * M_PI * ((i - 1) % (nu - 1)) / (nu - 1);
+            double theta = 2. * M_PI * ((j - 1) % (nv - 1)) / (nv - 1);
+            points(i, j) = gp_Pnt((R + r * std::cos(theta)) * std::cos(phi),
+                                  (R + r * std::cos(theta)) * std::sin(phi),
+                                  r * std::sin(theta));
+        }
+    }
+
+    auto params = BSplineAlgorithms::computeParamsBSplineSurf(points);
+    auto expected = pointsToSurfacePerColumn(points, params.first, params.second);
+    auto actual = BSplineAlgorithms::pointsToSurface(points, params.first, params.second, true, true);
+    expectSamePoles(expected, actual, 1e-10);
+}
+
+TEST(CurvesToSurface, matchesPerColumnInterpolation)
+{
+    // open and closed sets of profile curves with different knot vectors
+    for (bool closed : {false, true}) {
+        std::vector<Handle(Geom_BSplineCurve)> curves;
+        std::vector<Handle(Geom_Curve)> geomCurves;
+        const int nCurves = 7;
+        for (int k = 0; k < nCurves; ++k) {
+            double angle = closed ? 2. * M_PI * (k % (nCurves - 1)) / (nCurves - 1) : 0.3 * k;
+            Handle(TColgp_HArray1OfPnt) profile = new TColgp_HArray1OfPnt(1, 5 + k % 3);
+            for (int i = profile->Lower(); i <= profile->Upper(); ++i) {
+                double t = (i - 1.) / (profile->Length() - 1.);
+                double radius = 2. + t + 0.2 * std::sin(3. * t);
+                profile->SetValue(i, gp_Pnt(radius * std::cos(angle), radius * std::sin(angle), t * 4.));
+            }
+            curves.push_back(PointsToBSplineInterpolation(profile, 3).Curve());
+            geomCurves.push_back(curves.back());
+        }
+        if (closed) {
+            // the first and last curve must be equal to close the surface
+            curves.back() = curves.front();
+            geomCurves.back() = geomCurves.front();
+        }
+
+        CurvesToSurface skinner(geomCurves, true);
+        auto actual = skinner.Surface();
+        auto expected = skinPerColumn(curves, skinner.GetParameters(), true);
+        expectSamePoles(expected, actual, 1e-10);
+    }
+}
+
 TEST(BSplineAlgorithms, testCreateGordonSurface)
 {
     // Tests the method createGordonSurface
@@ -1547,6 +1715,183 @@ TEST_P(GordonSurface, testFromBRep)
     BRepTools::Write(BRepBuilderAPI_MakeFace(gordonSurface, Precision::Confusion()), path_output.c_str());
 }
 
+TEST_P(GordonSurface, incrementalUpdate)
+{
+    InterpolateCurveNetwork interpolator(splines_u_vector, splines_v_vector, 3e-4);
+    interpolator.Surface();
+
+    // replace a profile and a guide by their reversed copies
+    std::vector<Handle(Geom_Curve)> profiles = splines_u_vector;
+    std::vector<Handle(Geom_Curve)> guides = splines_v_vector;
+    profiles[1] = profiles[1]->Reversed();
+    guides[1] = guides[1]->Reversed();
+
+    interpolator.ReplaceProfile(1, profiles[1]);
+    interpolator.ReplaceGuide(1, guides[1]);
+    Handle(Geom_BSplineSurface) incremental = interpolator.Surface();
+
+    Handle(Geom_BSplineSurface) reference = InterpolateCurveNetwork(profiles, guides, 3e-4).Surface();
+
+    ASSERT_EQ(reference->NbUPoles(), incremental->NbUPoles());
+    ASSERT_EQ(reference->NbVPoles(), incremental->NbVPoles());
+    for (int i = 1; i <= reference->NbUPoles(); ++i) {
+        for (int j = 1; j <= reference->NbVPoles(); ++j) {
+            EXPECT_NEAR(0., reference->Pole(i, j).Distance(incremental->Pole(i, j)), 1e-10);
+        }
+    }
+
+    EXPECT_THROW(interpolator.ReplaceProfile(profiles.size(), profiles[0]), geoml::Error);
+}
+
+namespace
+{
+
+Handle(Geom_Curve) lineSegment(const gp_Pnt& p1, const gp_Pnt& p2)
+{
+    TColgp_Array1OfPnt poles(1, 2);
+    poles(1) = p1;
+    poles(2) = p2;
+    TColStd_Array1OfReal knots(1, 2);
+    knots(1) = 0.;
+    knots(2) = 1.;
+    TColStd_Array1OfInteger mults(1, 2);
+    mults(1) = 2;
+    mults(2) = 2;
+    return new Geom_BSplineCurve(poles, knots, mults, 1);
+}
+
+} // namespace
+
+TEST(InterpolateCurveNetwork, disjointCurvesArePrunedAndReported)
+{
+    // a planar grid of 3x3 lines. The outer curves only touch the
+    // bounding boxes of the other curves
+    std::vector<Handle(Geom_Curve)> profiles, guides;
+    for (int i = 0; i < 3; ++i) {
+        profiles.push_back(lineSegment(gp_Pnt(0., i, 0.), gp_Pnt(2., i, 0.)));
+        guides.push_back(lineSegment(gp_Pnt(i, 0., 0.), gp_Pnt(i, 2., 0.)));
+    }
+
+    InterpolateCurveNetwork interpolator(profiles, guides, 1e-4);
+    Handle(Geom_BSplineSurface) surface = interpolator.Surface();
+    ASSERT_FALSE(surface.IsNull());
+    EXPECT_NEAR(0., surface->Value(0.5, 0.5).Distance(gp_Pnt(1., 1., 0.)), 1e-8);
+
+    // the new guide is far above the profiles. Its bounding box is disjoint
+    // to the ones of all profiles, but the missing intersections are reported.
+    interpolator.ReplaceGuide(1, lineSegment(gp_Pnt(1., 0., 10.), gp_Pnt(1., 2., 10.)));
+    try {
+        interpolator.Surface();
+        FAIL() << "expected geoml::Error";
+    }
+    catch (const geoml::Error& err) {
+        EXPECT_NE(std::string::npos, std::string(err.what()).find("don't intersect"));
+    }
+
+    // the same holds for a network computed from scratch
+    guides[1] = lineSegment(gp_Pnt(1., 0., 10.), gp_Pnt(1., 2., 10.));
+    EXPECT_THROW(InterpolateCurveNetwork(profiles, guides, 1e-4).Surface(), geoml::Error);
+}
+
+TEST(InterpolateCurveNetwork, closedNetwork)
+{
+    // a cylinder of closed circular profiles. The first guide is repeated to close the network.
+    std::vector<Handle(Geom_Curve)> profiles, guides;
+    for (int i = 0; i < 4; ++i) {
+        profiles.push_back(new Geom_Circle(gp_Ax2(gp_Pnt(0., 0., i), gp_Dir(0., 0., 1.)), 1.));
+    }
+    const int nGuides = 6;
+    for (int j = 0; j <= nGuides; ++j) {
+        double angle = 2. * M_PI * (j % nGuides) / nGuides;
+        guides.push_back(lineSegment(gp_Pnt(std::cos(angle), std::sin(angle), 0.),
+                                     gp_Pnt(std::cos(angle), std::sin(angle), 3.)));
+    }
+
+    InterpolateCurveNetwork interpolator(profiles, guides, 1e-4);
+    Handle(Geom_BSplineSurface) surface = interpolator.Surface();
+    Handle(Geom_BSplineSurface) surfProfiles = interpolator.SurfaceProfiles();
+    Handle(Geom_BSplineSurface) surfGuides = interpolator.SurfaceGuides();
+    Handle(Geom_BSplineSurface) tensorProdSurf = interpolator.SurfaceIntersections();
+
+    // the Gordon surface shares the knots, weights and periodicity of the profile surface
+    EXPECT_EQ(surfProfiles->IsUPeriodic(), surface->IsUPeriodic());
+    EXPECT_EQ(surfProfiles->IsVPeriodic(), surface->IsVPeriodic());
+    ASSERT_EQ(surfProfiles->NbUKnots(), surface->NbUKnots());
+    ASSERT_EQ(surfProfiles->NbVKnots(), surface->NbVKnots());
+    for (int i = 1; i <= surface->NbUKnots(); ++i) {
+        EXPECT_EQ(surfProfiles->UKnot(i), surface->UKnot(i));
+        EXPECT_EQ(surfProfiles->UMultiplicity(i), surface->UMultiplicity(i));
+    }
+    for (int i = 1; i <= surface->NbVKnots(); ++i) {
+        EXPECT_EQ(surfProfiles->VKnot(i), surface->VKnot(i));
+        EXPECT_EQ(surfProfiles->VMultiplicity(i), surface->VMultiplicity(i));
+    }
+
+    // its poles are the superposition of the poles of the three surfaces
+    ASSERT_EQ(surfProfiles->NbUPoles(), surface->NbUPoles());
+    ASSERT_EQ(surfProfiles->NbVPoles(), surface->NbVPoles());
+    for (int i = 1; i <= surface->NbUPoles(); ++i) {
+        for (int j = 1; j <= surface->NbVPoles(); ++j) {
+            gp_Pnt expected(surfProfiles->Pole(i, j).XYZ() + surfGuides->Pole(i, j).XYZ() - tensorProdSurf->Pole(i, j).XYZ());
+            EXPECT_NEAR(0., surface->Pole(i, j).Distance(expected), 1e-12);
+            EXPECT_EQ(surfProfiles->Weight(i, j), surface->Weight(i, j));
+        }
+    }
+
+    // the surface is closed and interpolates the network
+    double u1, u2, v1, v2;
+    surface->Bounds(u1, u2, v1, v2);
+    for (double v : interpolator.ParametersProfiles()) {
+        EXPECT_NEAR(0., surface->Value(u1, v).Distance(surface->Value(u2, v)), 1e-8);
+        for (double u : interpolator.ParametersGuides()) {
+            gp_Pnt p = surface->Value(u, v);
+            EXPECT_NEAR(1., std::sqrt(p.X() * p.X() + p.Y() * p.Y()), 1e-4);
+            EXPECT_NEAR(std::round(p.Z()), p.Z(), 1e-4);
+        }
+    }
+}
+
+TEST(BSplineAlgorithms, createCommonKnotsVectorCurveMany)
+{
+    // many splines with different knots, one of them rational, are made compatible in parallel
+    std::vector<Handle(Geom_BSplineCurve)> splines;
+    for (int k = 0; k < 16; ++k) {
+        Handle(TColgp_HArray1OfPnt) points = new TColgp_HArray1OfPnt(1, 4 + k % 5);
+        for (int i = points->Lower(); i <= points->Upper(); ++i) {
+            double t = (i - 1.) / (points->Length() - 1.);
+            points->SetValue(i, gp_Pnt(t, std::sin(2. * t + 0.1 * k), 0.2 * k));
+        }
+        std::vector<double> params;
+        for (int i = 0; i < points->Length(); ++i) {
+            params.push_back(std::pow(static_cast<double>(i) / (points->Length() - 1.), 1. + 0.05 * k));
+        }
+        splines.push_back(PointsToBSplineInterpolation(points, params, 3).Curve());
+    }
+    Handle(Geom_BSplineCurve) rational = Handle(Geom_BSplineCurve)::DownCast(splines[3]->Copy());
+    rational->SetWeight(2, 2.);
+    splines[3] = rational;
+
+    std::vector<Handle(Geom_BSplineCurve)> compatible = BSplineAlgorithms::createCommonKnotsVectorCurve(splines, 1e-14);
+    ASSERT_EQ(splines.size(), compatible.size());
+
+    for (size_t k = 0; k < compatible.size(); ++k) {
+        // all splines share the knots of the first one
+        ASSERT_EQ(compatible[0]->NbKnots(), compatible[k]->NbKnots());
+        for (int i = 1; i <= compatible[0]->NbKnots(); ++i) {
+            EXPECT_NEAR(compatible[0]->Knot(i), compatible[k]->Knot(i), 1e-14);
+            EXPECT_EQ(compatible[0]->Multiplicity(i), compatible[k]->Multiplicity(i));
+        }
+
+        // knot insertion does not change the geometry and keeps the input untouched
+        EXPECT_NE(splines[k].get(), compatible[k].get());
+        EXPECT_EQ(splines[k]->IsRational(), compatible[k]->IsRational());
+        for (int i = 0; i <= 20; ++i) {
+            double t = i / 20.;
+            EXPECT_NEAR(0., splines[k]->Value(t).Distance(compatible[k]->Value(t)), 1e-12);
+        }
+    }
+}
+
 TEST_P(GordonSurface, testIntersectionRegressions)
 {
     math_Matrix intersection_params_u(0, splines_u_vector.size() - 1,